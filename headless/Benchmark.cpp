@@ -0,0 +1,65 @@
+//
+// Rendimiento de la simulación sin ventana a través de la API C.
+// Uso: headless_benchmark [episodios] [frameSkip]
+//
+#include "SimulationAPI.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+int main(int argc, char** argv) {
+    int episodes = argc > 1 ? std::atoi(argv[1]) : 200;
+    AbConfig config = ab_sim_default_config();
+    if (argc > 2) {
+        config.frameSkip = std::atoi(argv[2]);
+    }
+
+    AbSimulation* sim = ab_sim_create(&config);
+    if (!sim || episodes < 1) {
+        std::cerr << "[Benchmark] No se pudo crear la simulación" << std::endl;
+        ab_sim_destroy(sim);
+        return 1;
+    }
+
+    // Disparos aleatorios pero repetibles hacia la estructura
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> speedX(10.0f, 45.0f);
+    std::uniform_real_distribution<float> speedY(-25.0f, 0.0f);
+
+    const AbObservation* observation = ab_sim_observation(sim);
+    long long steps = 0;
+    int wins = 0;
+    double resetSeconds = 0.0;
+    float checksum = 0.0f; // Para que el compilador no descarte las lecturas
+
+    auto start = std::chrono::steady_clock::now();
+    for (int episode = 0; episode < episodes; ++episode) {
+        auto resetStart = std::chrono::steady_clock::now();
+        ab_sim_reset(sim);
+        resetSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - resetStart).count();
+
+        AbAction action = { speedX(rng), speedY(rng) };
+        int32_t done = ab_sim_step(sim, &action);
+        ++steps;
+        while (!done) {
+            done = ab_sim_step(sim, nullptr);
+            ++steps;
+        }
+
+        checksum += observation->target[AB_CHANNEL_POSITION_X];
+        wins += observation->won;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[Benchmark] " << episodes << " episodios, " << steps << " pasos (frameSkip "
+              << config.frameSkip << ", " << observation->bodyCount << " cuerpos), " << wins << " victorias\n"
+              << "  Tiempo total:       " << seconds << " s\n"
+              << "  Pasos por segundo:  " << steps / seconds << "\n"
+              << "  Física por segundo: " << steps * config.frameSkip / seconds << " pasos de Box2D\n"
+              << "  Reinicio medio:     " << resetSeconds * 1e6 / episodes << " us\n"
+              << "  (comprobación " << checksum << ")" << std::endl;
+
+    ab_sim_destroy(sim);
+    return 0;
+}
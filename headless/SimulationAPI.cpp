@@ -0,0 +1,202 @@
+#include "SimulationAPI.h"
+#include "Level.h"
+#include "PhysicsWrapper.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+struct AbSimulation {
+    AbConfig config;
+    std::unique_ptr<PhysicsWrapper> physics;
+    LevelBodies level;
+
+    // Se dimensiona una vez en ab_sim_create y no se vuelve a redimensionar,
+    // así que observation.data no cambia nunca
+    std::vector<float> buffer;
+    AbObservation observation;
+};
+
+namespace {
+    void WriteBody(float* channels, size_t stride, size_t index, const b2Body* body) {
+        const b2Vec2& position = body->GetPosition();
+        const b2Vec2& velocity = body->GetLinearVelocity();
+        channels[AB_CHANNEL_POSITION_X * stride + index] = position.x;
+        channels[AB_CHANNEL_POSITION_Y * stride + index] = position.y;
+        channels[AB_CHANNEL_ANGLE * stride + index] = body->GetAngle();
+        channels[AB_CHANNEL_VELOCITY_X * stride + index] = velocity.x;
+        channels[AB_CHANNEL_VELOCITY_Y * stride + index] = velocity.y;
+        channels[AB_CHANNEL_ANGULAR_VELOCITY * stride + index] = body->GetAngularVelocity();
+        channels[AB_CHANNEL_AWAKE * stride + index] = body->IsAwake() ? 1.0f : 0.0f;
+    }
+
+    // Vuelca el estado del mundo en el buffer sin cambiar su tamaño
+    void WriteObservation(AbSimulation& sim) {
+        const size_t capacity = static_cast<size_t>(sim.observation.capacity);
+        float* channels = sim.buffer.data();
+        const std::vector<b2Body*>& bodies = sim.level.dynamicBodies;
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            WriteBody(channels, capacity, i, bodies[i]);
+        }
+
+        // El objetivo, como un canal más de un solo elemento
+        WriteBody(channels + AB_CHANNEL_COUNT * capacity, 1, 0, sim.level.pig);
+    }
+
+    // Nivel nuevo sobre un mundo nuevo (ResetWorld recrea el b2World: los
+    // ids del broadphase y el orden de contactos no pasan de un episodio a
+    // otro). El PhysicsWrapper y sus buffers se conservan.
+    void BuildEpisode(AbSimulation& sim) {
+        sim.level = LevelBodies();
+        sim.physics->ResetWorld();
+        sim.level = BuildDefaultLevel(*sim.physics);
+    }
+
+    // Tras un fallo a medias el nivel no es fiable: se da por terminado
+    void AbortEpisode(AbSimulation& sim, const char* where, const char* what) {
+        std::cerr << "[SimulationAPI] Error en " << where << ": " << what << std::endl;
+        sim.level = LevelBodies();
+        sim.observation.done = 1;
+    }
+
+    int32_t IndexOf(const LevelBodies& level, const b2Body* body) {
+        auto it = std::find(level.dynamicBodies.begin(), level.dynamicBodies.end(), body);
+        return static_cast<int32_t>(it - level.dynamicBodies.begin());
+    }
+
+    // Tras el lanzamiento, el disparo termina cuando todo el nivel duerme
+    bool IsSettled(const LevelBodies& level) {
+        for (const b2Body* body : level.dynamicBodies) {
+            if (body->IsAwake()) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+AbConfig ab_sim_default_config(void) {
+    AbConfig config;
+    config.timeStep = 1.0f / 60.0f;
+    config.frameSkip = 1;
+    config.maxSteps = 600;
+    return config;
+}
+
+AbSimulation* ab_sim_create(const AbConfig* config) {
+    AbConfig settings = config ? *config : ab_sim_default_config();
+    if (!(settings.timeStep > 0.0f) || settings.frameSkip < 1 || settings.maxSteps < 0) {
+        std::cerr << "[SimulationAPI] Configuración no válida (timeStep " << settings.timeStep
+                  << ", frameSkip " << settings.frameSkip << ", maxSteps " << settings.maxSteps << ")" << std::endl;
+        return nullptr;
+    }
+
+    // Ninguna excepción debe cruzar la frontera C
+    try {
+        std::unique_ptr<AbSimulation> sim(new AbSimulation());
+        sim->config = settings;
+        sim->physics.reset(new PhysicsWrapper(b2Vec2(0.0f, kLevelGravity)));
+        sim->physics->SetContactLogging(false);
+        BuildEpisode(*sim); // Solo para medir el nivel
+
+        const int32_t bodyCount = static_cast<int32_t>(sim->level.dynamicBodies.size());
+        const int32_t capacity = (bodyCount + 3) & ~3;
+        sim->buffer.assign(static_cast<size_t>(AB_CHANNEL_COUNT) * (capacity + 1), 0.0f);
+
+        AbObservation& observation = sim->observation;
+        observation.data = sim->buffer.data();
+        observation.target = sim->buffer.data() + static_cast<size_t>(AB_CHANNEL_COUNT) * capacity;
+        observation.capacity = capacity;
+        observation.bodyCount = bodyCount;
+        observation.birdIndex = IndexOf(sim->level, sim->level.bird);
+        observation.targetIndex = IndexOf(sim->level, sim->level.pig);
+
+        if (!ab_sim_reset(sim.get())) {
+            return nullptr;
+        }
+        return sim.release();
+    } catch (const std::bad_alloc&) {
+        std::cerr << "[SimulationAPI] Sin memoria para crear la simulación" << std::endl;
+        return nullptr;
+    } catch (const std::exception& e) {
+        std::cerr << "[SimulationAPI] No se pudo crear la simulación: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void ab_sim_destroy(AbSimulation* sim) {
+    delete sim;
+}
+
+const AbObservation* ab_sim_reset(AbSimulation* sim) {
+    if (!sim) {
+        return nullptr;
+    }
+
+    AbObservation& observation = sim->observation;
+    try {
+        BuildEpisode(*sim);
+    } catch (const std::exception& e) {
+        AbortEpisode(*sim, "ab_sim_reset", e.what());
+        return nullptr;
+    } catch (...) {
+        AbortEpisode(*sim, "ab_sim_reset", "excepción desconocida");
+        return nullptr;
+    }
+
+    observation.stepCount = 0;
+    observation.reward = 0.0f;
+    observation.launched = 0;
+    observation.won = 0;
+    observation.done = 0;
+    WriteObservation(*sim);
+    return &observation;
+}
+
+int32_t ab_sim_step(AbSimulation* sim, const AbAction* action) {
+    if (!sim) {
+        return -1;
+    }
+
+    AbObservation& observation = sim->observation;
+    observation.reward = 0.0f;
+    if (observation.done) {
+        return 1;
+    }
+
+    // Ninguna excepción debe cruzar la frontera C
+    try {
+        if (action && !observation.launched) {
+            LaunchBird(*sim->physics, sim->level, b2Vec2(action->velocityX, action->velocityY));
+            observation.launched = 1;
+        }
+
+        for (int32_t i = 0; i < sim->config.frameSkip && !observation.won; ++i) {
+            sim->physics->Update(sim->config.timeStep);
+            observation.won = IsLevelWon(sim->level) ? 1 : 0;
+        }
+    } catch (const std::exception& e) {
+        AbortEpisode(*sim, "ab_sim_step", e.what());
+        return -1;
+    } catch (...) {
+        AbortEpisode(*sim, "ab_sim_step", "excepción desconocida");
+        return -1;
+    }
+    ++observation.stepCount;
+
+    if (observation.won) {
+        observation.reward = 1.0f;
+    }
+    bool outOfTime = sim->config.maxSteps > 0 && observation.stepCount >= sim->config.maxSteps;
+    bool settled = observation.launched && IsSettled(sim->level);
+    observation.done = (observation.won || outOfTime || settled) ? 1 : 0;
+
+    WriteObservation(*sim);
+    return observation.done;
+}
+
+const AbObservation* ab_sim_observation(const AbSimulation* sim) {
+    return sim ? &sim->observation : nullptr;
+}
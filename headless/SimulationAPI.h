@@ -0,0 +1,104 @@
+//
+// API C de la simulación sin ventana, para entornos de entrenamiento.
+//
+#ifndef SIMULATIONAPI_H
+#define SIMULATIONAPI_H
+
+#include <stdint.h>
+
+// AB_BUILDING_LIBRARY solo al compilar la biblioteca (lo pone el Makefile);
+// quien la usa importa los símbolos
+#if defined(_WIN32)
+#if defined(AB_BUILDING_LIBRARY)
+#define AB_API __declspec(dllexport)
+#else
+#define AB_API __declspec(dllimport)
+#endif
+#else
+#define AB_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// El nivel por defecto del juego (src/Level.h) sobre un PhysicsWrapper, sin
+// SFML. Un episodio es un disparo: se lanza el pájaro y se avanza hasta que
+// el cerdo cae, todo se duerme o se agota maxSteps.
+typedef struct AbSimulation AbSimulation;
+
+typedef struct AbConfig {
+    float timeStep;     // Segundos por paso de física
+    int32_t frameSkip;  // Pasos de física por ab_sim_step
+    int32_t maxSteps;   // ab_sim_step por episodio; 0 = sin límite
+} AbConfig;
+
+// Velocidad de lanzamiento del pájaro en m/s (y hacia abajo). Solo cuenta en
+// el primer ab_sim_step que la recibe; después se ignora.
+typedef struct AbAction {
+    float velocityX;
+    float velocityY;
+} AbAction;
+
+// Canales del buffer de observación, en este orden
+enum {
+    AB_CHANNEL_POSITION_X,
+    AB_CHANNEL_POSITION_Y,
+    AB_CHANNEL_ANGLE,
+    AB_CHANNEL_VELOCITY_X,
+    AB_CHANNEL_VELOCITY_Y,
+    AB_CHANNEL_ANGULAR_VELOCITY,
+    AB_CHANNEL_AWAKE,  // 1.0 despierto, 0.0 dormido
+    AB_CHANNEL_COUNT
+};
+
+// Observación sin copias. data es un bloque contiguo de floats en SoA:
+// AB_CHANNEL_COUNT canales de capacity floats (el canal c empieza en
+// data + c * capacity) seguidos de los AB_CHANNEL_COUNT valores del objetivo
+// (target). capacity es bodyCount redondeado a múltiplo de 4; el relleno
+// queda a cero.
+//
+// La estructura y el buffer los reescriben ab_sim_reset y ab_sim_step en el
+// sitio: los punteros valen mientras viva la simulación, así que se pueden
+// envolver una vez (numpy.frombuffer, torch.from_blob) y leer tras cada paso.
+typedef struct AbObservation {
+    const float* data;
+    const float* target;
+    int32_t capacity;
+    int32_t bodyCount;   // Cuerpos dinámicos del nivel; el índice de cada uno es fijo
+    int32_t birdIndex;
+    int32_t targetIndex;
+    int64_t stepCount;   // ab_sim_step del episodio actual
+    float reward;        // 1.0 en el paso en que cae el cerdo, 0.0 en los demás
+    int32_t launched;
+    int32_t won;
+    int32_t done;
+} AbObservation;
+
+// timeStep 1/60, frameSkip 1, maxSteps 600
+AB_API AbConfig ab_sim_default_config(void);
+
+// config puede ser NULL (valores por defecto). Devuelve NULL si la
+// configuración no es válida o falla la creación. La simulación empieza ya
+// reiniciada.
+AB_API AbSimulation* ab_sim_create(const AbConfig* config);
+AB_API void ab_sim_destroy(AbSimulation* sim);
+
+// Nivel recién creado sobre un b2World nuevo; el resto de la simulación
+// (partículas, colas, buffers) se reutiliza sin reservar nada. Dos reinicios
+// dan la misma secuencia. NULL si falla (p.ej. sin memoria): el episodio
+// queda terminado y se puede volver a intentar.
+AB_API const AbObservation* ab_sim_reset(AbSimulation* sim);
+
+// action puede ser NULL (esperar). Avanza frameSkip pasos de física, salvo
+// que el episodio ya haya terminado, y devuelve done (0 o 1), o -1 si falla:
+// el episodio queda terminado y hay que llamar a ab_sim_reset.
+AB_API int32_t ab_sim_step(AbSimulation* sim, const AbAction* action);
+
+AB_API const AbObservation* ab_sim_observation(const AbSimulation* sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SIMULATIONAPI_H
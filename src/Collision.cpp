@@ -1,6 +1,9 @@
 #include "Collision.h"
 #include <cmath>
-#include <iostream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace Collision {
 
@@ -89,7 +92,6 @@ namespace Collision {
         }
 
         result.hasCollision = true;
-        std::cout<<"Collision with my own logic"<<std::endl;
         return result;
     }
 
@@ -177,4 +179,476 @@ namespace Collision {
 
         return result;
     }
+
+    namespace {
+        // Como ProjectVertices, sobre un array
+        void ProjectPoints(const b2Vec2* points, int32 count, const b2Vec2& axis, float& min, float& max) {
+            min = std::numeric_limits<float>::max();
+            max = -std::numeric_limits<float>::max();
+            for (int32 i = 0; i < count; ++i) {
+                float proj = b2Dot(points[i], axis);
+                min = std::min(min, proj);
+                max = std::max(max, proj);
+            }
+        }
+
+        bool TestCircleAxis(const Circle& circle, const b2Vec2* vertices, int32 vertexCount, const b2Vec2& axis,
+                            ContactInfo& result) {
+            float minPoly, maxPoly, minCircle, maxCircle;
+            ProjectPoints(vertices, vertexCount, axis, minPoly, maxPoly);
+            ProjectCircle(circle, axis, minCircle, maxCircle);
+
+            if (maxPoly < minCircle || maxCircle < minPoly) {
+                return false;
+            }
+
+            float overlap = std::min(maxPoly, maxCircle) - std::max(minPoly, minCircle);
+            if (overlap < result.depth) {
+                result.depth = overlap;
+                result.normal = axis;
+            }
+            return true;
+        }
+
+        // CheckCircleToPolygon sobre arrays, con los ejes SAT explícitos:
+        // mismos pasos y mismo orden de operaciones que el kernel de Polygon
+        ContactInfo CheckCircleToPolygonAxes(const Circle& circle, const b2Vec2* vertices, int32 vertexCount,
+                                             const b2Vec2* axes, int32 axisCount) {
+            ContactInfo result;
+            result.depth = std::numeric_limits<float>::max();
+
+            for (int32 i = 0; i < axisCount; ++i) {
+                if (!TestCircleAxis(circle, vertices, vertexCount, axes[i], result)) {
+                    return result;
+                }
+            }
+
+            float minDistSq = std::numeric_limits<float>::max();
+            b2Vec2 closestPoint = vertices[0];
+            for (int32 i = 0; i < vertexCount; ++i) {
+                b2Vec2 pointOnEdge = GetClosestPointOnEdge(circle.center, vertices[i], vertices[(i + 1) % vertexCount]);
+                float distSq = (circle.center - pointOnEdge).LengthSquared();
+                if (distSq < minDistSq) {
+                    minDistSq = distSq;
+                    closestPoint = pointOnEdge;
+                }
+            }
+
+            b2Vec2 axis = circle.center - closestPoint;
+            float distSq = axis.LengthSquared();
+            if (distSq > 1e-6f) {
+                axis = (1.0f / std::sqrt(distSq)) * axis;
+                if (!TestCircleAxis(circle, vertices, vertexCount, axis, result)) {
+                    return result;
+                }
+            }
+
+            b2Vec2 polyCenter(0.0f, 0.0f);
+            for (int32 i = 0; i < vertexCount; ++i) {
+                polyCenter += vertices[i];
+            }
+            polyCenter = (1.0f / vertexCount) * polyCenter;
+            if (b2Dot(circle.center - polyCenter, result.normal) < 0.0f) {
+                result.normal = -result.normal;
+            }
+
+            result.hasCollision = true;
+            result.contactPoint = closestPoint;
+            return result;
+        }
+    }
+
+#if defined(__SSE2__)
+    namespace {
+        inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        void StoreResults(ContactInfo* results, int32 lanes, __m128 hit, __m128 nx, __m128 ny,
+                          __m128 depth, __m128 px, __m128 py) {
+            alignas(16) float h[4], x[4], y[4], d[4], cx[4], cy[4];
+            _mm_store_ps(h, hit);
+            _mm_store_ps(x, nx);
+            _mm_store_ps(y, ny);
+            _mm_store_ps(d, depth);
+            _mm_store_ps(cx, px);
+            _mm_store_ps(cy, py);
+
+            for (int32 k = 0; k < lanes; ++k) {
+                ContactInfo& r = results[k];
+                r = ContactInfo();
+                if (h[k] != 0.0f) {
+                    r.hasCollision = true;
+                    r.normal.Set(x[k], y[k]);
+                    r.depth = d[k];
+                    r.contactPoint.Set(cx[k], cy[k]);
+                }
+            }
+        }
+
+        // Carga hasta cuatro floats; los carriles sobrantes se rellenan con fill
+        inline __m128 LoadPartial(const float* p, int32 lanes, float fill) {
+            if (lanes == 4) {
+                return _mm_loadu_ps(p);
+            }
+            alignas(16) float tmp[4] = { fill, fill, fill, fill };
+            for (int32 k = 0; k < lanes; ++k) {
+                tmp[k] = p[k];
+            }
+            return _mm_load_ps(tmp);
+        }
+    }
+#endif
+
+    void CheckCirclesToCircles(const float* ax, const float* ay, const float* ar,
+                               const float* bx, const float* by, const float* br,
+                               int32 count, ContactInfo* results) {
+        int32 i = 0;
+#if defined(__SSE2__)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        for (; i < count; i += 4) {
+            int32 lanes = std::min<int32>(4, count - i);
+            __m128 axv = LoadPartial(ax + i, lanes, 0.0f);
+            __m128 ayv = LoadPartial(ay + i, lanes, 0.0f);
+            __m128 arv = LoadPartial(ar + i, lanes, 0.0f);
+            __m128 bxv = LoadPartial(bx + i, lanes, 1.0e6f);
+            __m128 byv = LoadPartial(by + i, lanes, 0.0f);
+            __m128 brv = LoadPartial(br + i, lanes, 0.0f);
+
+            __m128 dx = _mm_sub_ps(bxv, axv);
+            __m128 dy = _mm_sub_ps(byv, ayv);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 radiiSum = _mm_add_ps(arv, brv);
+            __m128 hit = _mm_cmplt_ps(distSq, _mm_mul_ps(radiiSum, radiiSum));
+
+            __m128 dist = _mm_sqrt_ps(distSq);
+            __m128 nonDegenerate = _mm_cmpgt_ps(dist, zero);
+            // Evita 1/0 en los carriles degenerados; se corrigen con Select
+            __m128 invDist = _mm_div_ps(one, Select(nonDegenerate, dist, one));
+
+            // Distancia cero: normal (1, 0), profundidad = suma de radios, punto = centro de a
+            __m128 nx = Select(nonDegenerate, _mm_mul_ps(dx, invDist), one);
+            __m128 ny = Select(nonDegenerate, _mm_mul_ps(dy, invDist), zero);
+            __m128 depth = _mm_sub_ps(radiiSum, dist);
+            __m128 px = _mm_add_ps(axv, _mm_mul_ps(arv, nx));
+            __m128 py = _mm_add_ps(ayv, _mm_mul_ps(arv, ny));
+            px = Select(nonDegenerate, px, axv);
+            py = Select(nonDegenerate, py, ayv);
+
+            StoreResults(results + i, lanes, hit, nx, ny, depth, px, py);
+        }
+#endif
+        for (; i < count; ++i) {
+            results[i] = CheckCircleToCircle(Circle{ b2Vec2(ax[i], ay[i]), ar[i] },
+                                             Circle{ b2Vec2(bx[i], by[i]), br[i] });
+        }
+    }
+
+#if defined(__SSE2__)
+    namespace {
+        // Un eje SAT en los cuatro carriles, como TestCircleAxis: solo en los
+        // carriles de test que siguen vivos; un eje separador los apaga.
+        inline void TestCircleAxis(__m128 minPoly, __m128 maxPoly, __m128 centerProj, __m128 r,
+                                   __m128 axisX, __m128 axisY, __m128 test,
+                                   __m128& alive, __m128& depth, __m128& nx, __m128& ny) {
+            __m128 minCircle = _mm_sub_ps(centerProj, r);
+            __m128 maxCircle = _mm_add_ps(centerProj, r);
+            __m128 separated = _mm_or_ps(_mm_cmplt_ps(maxPoly, minCircle), _mm_cmplt_ps(maxCircle, minPoly));
+            test = _mm_and_ps(test, alive);
+            alive = _mm_andnot_ps(_mm_and_ps(test, separated), alive);
+
+            // std::min(a, b) es _mm_min_ps(b, a) y std::max(a, b) es _mm_max_ps(b, a)
+            __m128 overlap = _mm_sub_ps(_mm_min_ps(maxCircle, maxPoly), _mm_max_ps(minCircle, minPoly));
+            __m128 better = _mm_and_ps(_mm_andnot_ps(separated, test), _mm_cmplt_ps(overlap, depth));
+            depth = Select(better, overlap, depth);
+            nx = Select(better, axisX, nx);
+            ny = Select(better, axisY, ny);
+        }
+    }
+#endif
+
+    void CheckCirclesToPolygon(const float* cx, const float* cy, const float* cr, int32 count,
+                               const b2Vec2* vertices, int32 vertexCount, const b2Vec2* axes, int32 axisCount,
+                               ContactInfo* results) {
+        int32 i = 0;
+#if defined(__SSE2__)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 allLanes = _mm_cmpeq_ps(zero, zero);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 maxFloat = _mm_set1_ps(std::numeric_limits<float>::max());
+        const __m128 minDistance = _mm_set1_ps(1e-6f);
+
+        // Lo que no depende del círculo: proyección del polígono en sus ejes y centro
+        float faceMin[b2_maxPolygonVertices], faceMax[b2_maxPolygonVertices];
+        for (int32 a = 0; a < axisCount; ++a) {
+            ProjectPoints(vertices, vertexCount, axes[a], faceMin[a], faceMax[a]);
+        }
+        b2Vec2 polyCenter(0.0f, 0.0f);
+        for (int32 v = 0; v < vertexCount; ++v) {
+            polyCenter += vertices[v];
+        }
+        polyCenter = (1.0f / vertexCount) * polyCenter;
+
+        for (; i < count; i += 4) {
+            int32 lanes = std::min<int32>(4, count - i);
+            __m128 x = LoadPartial(cx + i, lanes, 0.0f);
+            __m128 y = LoadPartial(cy + i, lanes, 0.0f);
+            __m128 r = LoadPartial(cr + i, lanes, 0.0f);
+
+            __m128 alive = allLanes;
+            __m128 depth = maxFloat;
+            __m128 nx = zero, ny = zero;
+
+            for (int32 a = 0; a < axisCount; ++a) {
+                __m128 axisX = _mm_set1_ps(axes[a].x), axisY = _mm_set1_ps(axes[a].y);
+                __m128 centerProj = _mm_add_ps(_mm_mul_ps(x, axisX), _mm_mul_ps(y, axisY));
+                TestCircleAxis(_mm_set1_ps(faceMin[a]), _mm_set1_ps(faceMax[a]), centerProj, r,
+                               axisX, axisY, allLanes, alive, depth, nx, ny);
+            }
+
+            // Punto más cercano del borde, arista a arista como GetClosestPointOnEdge
+            __m128 closestDistSq = maxFloat;
+            __m128 qx = _mm_set1_ps(vertices[0].x), qy = _mm_set1_ps(vertices[0].y);
+            for (int32 e = 0; e < vertexCount; ++e) {
+                const b2Vec2& p1 = vertices[e];
+                b2Vec2 edge = vertices[(e + 1) % vertexCount] - p1;
+                float edgeLengthSq = edge.LengthSquared();
+                __m128 px = _mm_set1_ps(p1.x), py = _mm_set1_ps(p1.y);
+                if (edgeLengthSq >= 1e-6f) {
+                    __m128 ex = _mm_set1_ps(edge.x), ey = _mm_set1_ps(edge.y);
+                    __m128 dot = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, px), ex), _mm_mul_ps(_mm_sub_ps(y, py), ey));
+                    __m128 t = _mm_div_ps(dot, _mm_set1_ps(edgeLengthSq));
+                    t = _mm_max_ps(zero, _mm_min_ps(t, one));
+                    px = _mm_add_ps(px, _mm_mul_ps(t, ex));
+                    py = _mm_add_ps(py, _mm_mul_ps(t, ey));
+                }
+                __m128 dx = _mm_sub_ps(x, px);
+                __m128 dy = _mm_sub_ps(y, py);
+                __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+                __m128 closer = _mm_cmplt_ps(distSq, closestDistSq);
+                closestDistSq = Select(closer, distSq, closestDistSq);
+                qx = Select(closer, px, qx);
+                qy = Select(closer, py, qy);
+            }
+
+            // Eje del punto más cercano al centro, si no son el mismo punto
+            __m128 dx = _mm_sub_ps(x, qx);
+            __m128 dy = _mm_sub_ps(y, qy);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 far = _mm_cmpgt_ps(distSq, minDistance);
+            __m128 invDist = _mm_div_ps(one, _mm_sqrt_ps(Select(far, distSq, one)));
+            __m128 axisX = _mm_mul_ps(invDist, dx);
+            __m128 axisY = _mm_mul_ps(invDist, dy);
+            __m128 minPoly = maxFloat;
+            __m128 maxPoly = _mm_xor_ps(maxFloat, signBit);
+            for (int32 v = 0; v < vertexCount; ++v) {
+                __m128 proj = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(vertices[v].x), axisX),
+                                         _mm_mul_ps(_mm_set1_ps(vertices[v].y), axisY));
+                minPoly = _mm_min_ps(proj, minPoly);
+                maxPoly = _mm_max_ps(proj, maxPoly);
+            }
+            __m128 centerProj = _mm_add_ps(_mm_mul_ps(x, axisX), _mm_mul_ps(y, axisY));
+            TestCircleAxis(minPoly, maxPoly, centerProj, r, axisX, axisY, far, alive, depth, nx, ny);
+
+            // Normal del polígono hacia el círculo
+            __m128 toCircle = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(polyCenter.x)), nx),
+                                         _mm_mul_ps(_mm_sub_ps(y, _mm_set1_ps(polyCenter.y)), ny));
+            __m128 flip = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(toCircle, zero), alive), signBit);
+            nx = _mm_xor_ps(nx, flip);
+            ny = _mm_xor_ps(ny, flip);
+
+            // Sin colisión se conservan profundidad y normal hasta el eje separador
+            alignas(16) float h[4], nxs[4], nys[4], d[4], pxs[4], pys[4];
+            _mm_store_ps(h, alive);
+            _mm_store_ps(nxs, nx);
+            _mm_store_ps(nys, ny);
+            _mm_store_ps(d, depth);
+            _mm_store_ps(pxs, qx);
+            _mm_store_ps(pys, qy);
+            for (int32 k = 0; k < lanes; ++k) {
+                ContactInfo& result = results[i + k];
+                result = ContactInfo();
+                result.hasCollision = h[k] != 0.0f;
+                result.normal.Set(nxs[k], nys[k]);
+                result.depth = d[k];
+                if (result.hasCollision) {
+                    result.contactPoint.Set(pxs[k], pys[k]);
+                }
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            results[i] = CheckCircleToPolygonAxes(Circle{ b2Vec2(cx[i], cy[i]), cr[i] },
+                                                  vertices, vertexCount, axes, axisCount);
+        }
+    }
+
+    namespace {
+        const int32 kMaxTOIIterations = 32;
+
+        // Forma convexa genérica para el avance conservador: un punto (círculo)
+        // o un polígono, más un radio.
+        struct SweptShape {
+            const b2Vec2* localPoints;
+            int32 count;
+            float radius;
+        };
+
+        bool IntervalsSeparated(const b2Vec2* a, int32 na, const b2Vec2* b, int32 nb, const b2Vec2& axis) {
+            float minA = std::numeric_limits<float>::max(), maxA = -minA;
+            float minB = minA, maxB = -minA;
+            for (int32 i = 0; i < na; ++i) {
+                float p = b2Dot(a[i], axis);
+                minA = std::min(minA, p);
+                maxA = std::max(maxA, p);
+            }
+            for (int32 i = 0; i < nb; ++i) {
+                float p = b2Dot(b[i], axis);
+                minB = std::min(minB, p);
+                maxB = std::max(maxB, p);
+            }
+            return maxA < minB || maxB < minA;
+        }
+
+        // ¿Se solapan dos conjuntos convexos? SAT con las aristas de ambos
+        bool HullsOverlap(const b2Vec2* a, int32 na, const b2Vec2* b, int32 nb) {
+            const b2Vec2* sets[2] = { a, b };
+            int32 counts[2] = { na, nb };
+            for (int s = 0; s < 2; ++s) {
+                if (counts[s] < 2) {
+                    continue;
+                }
+                for (int32 i = 0; i < counts[s]; ++i) {
+                    b2Vec2 edge = sets[s][(i + 1) % counts[s]] - sets[s][i];
+                    if (IntervalsSeparated(a, na, b, nb, b2Vec2(-edge.y, edge.x))) {
+                        return false;
+                    }
+                }
+            }
+            // Dos puntos sueltos solo se solapan si coinciden
+            return na > 1 || nb > 1 || a[0] == b[0];
+        }
+
+        // Distancia entre dos conjuntos convexos (0 si se solapan) y los puntos más cercanos
+        float HullDistance(const b2Vec2* a, int32 na, const b2Vec2* b, int32 nb, b2Vec2& pa, b2Vec2& pb) {
+            float best = std::numeric_limits<float>::max();
+
+            auto testPointAgainst = [&](const b2Vec2& p, const b2Vec2* hull, int32 n, bool pointIsA) {
+                for (int32 i = 0; i < n; ++i) {
+                    b2Vec2 q = n == 1 ? hull[0] : GetClosestPointOnEdge(p, hull[i], hull[(i + 1) % n]);
+                    float distSq = (p - q).LengthSquared();
+                    if (distSq < best) {
+                        best = distSq;
+                        pa = pointIsA ? p : q;
+                        pb = pointIsA ? q : p;
+                    }
+                }
+            };
+
+            for (int32 i = 0; i < na; ++i) {
+                testPointAgainst(a[i], b, nb, true);
+            }
+            for (int32 i = 0; i < nb; ++i) {
+                testPointAgainst(b[i], a, na, false);
+            }
+
+            if (HullsOverlap(a, na, b, nb)) {
+                return 0.0f;
+            }
+            return std::sqrt(best);
+        }
+
+        float MaxExtent(const SweptShape& shape, const b2Vec2& localCenter) {
+            float extent = 0.0f;
+            for (int32 i = 0; i < shape.count; ++i) {
+                extent = std::max(extent, (shape.localPoints[i] - localCenter).Length());
+            }
+            return extent + shape.radius;
+        }
+
+        TOIResult ConservativeAdvancement(const SweptShape& shapeA, const b2Sweep& sweepA,
+                                          const SweptShape& shapeB, const b2Sweep& sweepB) {
+            TOIResult result;
+            const float target = b2_linearSlop;
+            const float tolerance = 0.25f * b2_linearSlop;
+
+            // Cota del desplazamiento relativo de cualquier punto durante el barrido
+            float extentA = MaxExtent(shapeA, sweepA.localCenter);
+            float extentB = MaxExtent(shapeB, sweepB.localCenter);
+            float motionBound = ((sweepA.c - sweepA.c0) - (sweepB.c - sweepB.c0)).Length()
+                              + std::abs(sweepA.a - sweepA.a0) * extentA
+                              + std::abs(sweepB.a - sweepB.a0) * extentB;
+
+            b2Vec2 worldA[b2_maxPolygonVertices];
+            b2Vec2 worldB[b2_maxPolygonVertices];
+            float t = 0.0f;
+
+            for (int32 iteration = 0; ; ++iteration) {
+                b2Transform xfA, xfB;
+                sweepA.GetTransform(&xfA, t);
+                sweepB.GetTransform(&xfB, t);
+                for (int32 i = 0; i < shapeA.count; ++i) {
+                    worldA[i] = b2Mul(xfA, shapeA.localPoints[i]);
+                }
+                for (int32 i = 0; i < shapeB.count; ++i) {
+                    worldB[i] = b2Mul(xfB, shapeB.localPoints[i]);
+                }
+
+                b2Vec2 pa = worldA[0], pb = worldB[0];
+                float distance = HullDistance(worldA, shapeA.count, worldB, shapeB.count, pa, pb)
+                               - shapeA.radius - shapeB.radius;
+
+                // Sin converger en kMaxTOIIterations (rozando en paralelo, por
+                // ejemplo) se da el impacto en el último t seguro, como el
+                // e_failed de b2TimeOfImpact: mejor pararse antes que atravesar
+                if (distance < target + tolerance || iteration == kMaxTOIIterations) {
+                    result.hit = true;
+                    result.t = t;
+                    b2Vec2 d = pb - pa;
+                    if (d.LengthSquared() > 1e-12f) {
+                        d.Normalize();
+                    } else {
+                        d = xfB.p - xfA.p;
+                        d.Normalize();
+                    }
+                    result.normal = d;
+                    result.contactPoint = pa + shapeA.radius * d;
+                    return result;
+                }
+
+                if (motionBound <= std::numeric_limits<float>::epsilon()) {
+                    return result; // Sin movimiento relativo no habrá impacto
+                }
+
+                t += (distance - target) / motionBound;
+                if (t >= 1.0f) {
+                    return result;
+                }
+            }
+        }
+
+        SweptShape ToSweptShape(const Circle& circle) {
+            return SweptShape{ &circle.center, 1, circle.radius };
+        }
+
+        SweptShape ToSweptShape(const Polygon& polygon) {
+            int32 count = std::min<int32>(static_cast<int32>(polygon.vertices.size()), b2_maxPolygonVertices);
+            return SweptShape{ polygon.vertices.data(), count, 0.0f };
+        }
+    }
+
+    TOIResult TimeOfImpact(const Circle& circleA, const b2Sweep& sweepA, const Circle& circleB, const b2Sweep& sweepB) {
+        return ConservativeAdvancement(ToSweptShape(circleA), sweepA, ToSweptShape(circleB), sweepB);
+    }
+
+    TOIResult TimeOfImpact(const Circle& circleA, const b2Sweep& sweepA, const Polygon& polygonB, const b2Sweep& sweepB) {
+        return ConservativeAdvancement(ToSweptShape(circleA), sweepA, ToSweptShape(polygonB), sweepB);
+    }
+
+    TOIResult TimeOfImpact(const Polygon& polygonA, const b2Sweep& sweepA, const Polygon& polygonB, const b2Sweep& sweepB) {
+        return ConservativeAdvancement(ToSweptShape(polygonA), sweepA, ToSweptShape(polygonB), sweepB);
+    }
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <utility>
+#include <cmath>
 
 struct Circle {
     b2Vec2 center;
@@ -46,6 +48,34 @@ struct Polygon {
     }
 };
 
+// Polígono convexo con número de vértices fijo en compilación, para los
+// kernels SAT desenrollados. Axes < N cuando las aristas opuestas son
+// paralelas: una caja solo tiene dos ejes únicos.
+template <int N, int Axes = N>
+struct FixedPolygon {
+    static_assert(Axes >= 1 && Axes <= N, "Un polígono no puede tener más ejes que aristas");
+
+    b2Vec2 vertices[N];
+    b2Vec2 normals[Axes];
+
+    b2Vec2 GetCenter() const {
+        return GetCenter(std::make_index_sequence<N>());
+    }
+
+private:
+    template <size_t... I>
+    b2Vec2 GetCenter(std::index_sequence<I...>) const {
+        b2Vec2 center(0.0f, 0.0f);
+        ((center += vertices[I]), ...);
+        return (1.0f / N) * center;
+    }
+};
+
+using FixedTriangle = FixedPolygon<3>;
+using FixedBox = FixedPolygon<4, 2>;
+using FixedQuad = FixedPolygon<4>;
+using FixedHexagon = FixedPolygon<6>;
+
 struct ContactInfo {
     bool hasCollision = false;
     b2Vec2 normal = b2Vec2_zero;
@@ -53,15 +83,173 @@ struct ContactInfo {
     b2Vec2 contactPoint = b2Vec2_zero; // Punto de contacto opcional
 };
 
+// Resultado del tiempo de impacto; t es la fracción del barrido [0, 1]
+struct TOIResult {
+    bool hit = false;
+    float t = 1.0f;
+    b2Vec2 normal = b2Vec2_zero;       // De A hacia B en el instante t
+    b2Vec2 contactPoint = b2Vec2_zero; // Sobre la superficie de A
+};
+
 namespace Collision {
     ContactInfo CheckCircleToCircle(const Circle& a, const Circle& b);
     ContactInfo CheckPolygonToPolygon(const Polygon& a, const Polygon& b);
     ContactInfo CheckCircleToPolygon(const Circle& circle, const Polygon& polygon);
 
+    // Versiones por lotes (SoA) para escenas con muchos círculos; procesan
+    // cuatro pares a la vez con SSE2 y dan los mismos resultados que las
+    // funciones de un solo par. results debe tener espacio para count elementos.
+    void CheckCirclesToCircles(const float* ax, const float* ay, const float* ar,
+                               const float* bx, const float* by, const float* br,
+                               int32 count, ContactInfo* results);
+
+    // Muchos círculos contra un mismo polígono convexo. axes son los ejes SAT
+    // del polígono tal y como los usa el kernel de un solo par (p.ej. solo dos
+    // en una caja); el resultado es idéntico, bit a bit, al de CheckCircleToPolygon.
+    void CheckCirclesToPolygon(const float* cx, const float* cy, const float* cr, int32 count,
+                               const b2Vec2* vertices, int32 vertexCount, const b2Vec2* axes, int32 axisCount,
+                               ContactInfo* results);
+
+    // Tiempo de impacto por avance conservador. Las formas van en coordenadas
+    // locales de su cuerpo y cada b2Sweep cubre el paso completo. Hay impacto
+    // cuando la distancia entre superficies baja de b2_linearSlop, o en el
+    // último t seguro si el avance no converge.
+    TOIResult TimeOfImpact(const Circle& circleA, const b2Sweep& sweepA, const Circle& circleB, const b2Sweep& sweepB);
+    TOIResult TimeOfImpact(const Circle& circleA, const b2Sweep& sweepA, const Polygon& polygonB, const b2Sweep& sweepB);
+    TOIResult TimeOfImpact(const Polygon& polygonA, const b2Sweep& sweepA, const Polygon& polygonB, const b2Sweep& sweepB);
+
     // Funciones auxiliares
     void ProjectVertices(const std::vector<b2Vec2>& vertices, const b2Vec2& axis, float& min, float& max);
     void ProjectCircle(const Circle& circle, const b2Vec2& axis, float& min, float& max);
     b2Vec2 GetClosestPointOnEdge(const b2Vec2& point, const b2Vec2& edgeStart, const b2Vec2& edgeEnd);
 }
 
+// --- Kernels SAT especializados por número de vértices ---
+// Mismo resultado que las versiones con Polygon, pero sin vectores ni módulos:
+// todos los bucles se desenrollan en compilación.
+namespace Collision {
+    namespace Detail {
+        template <int N, size_t... I>
+        inline void ProjectFixed(const b2Vec2 (&vertices)[N], const b2Vec2& axis, float& min, float& max,
+                                 std::index_sequence<I...>) {
+            const float p[N] = { b2Dot(vertices[I], axis)... };
+            min = p[0];
+            max = p[0];
+            ((min = std::min(min, p[I]), max = std::max(max, p[I])), ...);
+        }
+
+        template <int N>
+        inline void ProjectFixed(const b2Vec2 (&vertices)[N], const b2Vec2& axis, float& min, float& max) {
+            ProjectFixed<N>(vertices, axis, min, max, std::make_index_sequence<N>());
+        }
+
+        inline bool AccumulateOverlap(float minA, float maxA, float minB, float maxB, const b2Vec2& axis,
+                                      ContactInfo& result) {
+            if (maxA < minB || maxB < minA) {
+                return false;
+            }
+            float overlap = std::min(maxA, maxB) - std::max(minA, minB);
+            if (overlap < result.depth) {
+                result.depth = overlap;
+                result.normal = axis;
+            }
+            return true;
+        }
+
+        template <int N, int M>
+        inline bool TestPolygonAxis(const b2Vec2 (&a)[N], const b2Vec2 (&b)[M], const b2Vec2& axis, ContactInfo& result) {
+            float minA, maxA, minB, maxB;
+            ProjectFixed(a, axis, minA, maxA);
+            ProjectFixed(b, axis, minB, maxB);
+            return AccumulateOverlap(minA, maxA, minB, maxB, axis, result);
+        }
+
+        // El && del fold corta en el primer eje separador, como el bucle genérico
+        template <int N, int M, int Axes, size_t... I>
+        inline bool TestPolygonAxes(const b2Vec2 (&a)[N], const b2Vec2 (&b)[M], const b2Vec2 (&axes)[Axes],
+                                    ContactInfo& result, std::index_sequence<I...>) {
+            return (TestPolygonAxis(a, b, axes[I], result) && ...);
+        }
+
+        template <int N>
+        inline bool TestCircleAxis(const b2Vec2 (&vertices)[N], const Circle& circle, const b2Vec2& axis,
+                                   ContactInfo& result) {
+            float minPoly, maxPoly;
+            ProjectFixed(vertices, axis, minPoly, maxPoly);
+            float centerProj = b2Dot(circle.center, axis);
+            return AccumulateOverlap(minPoly, maxPoly, centerProj - circle.radius, centerProj + circle.radius,
+                                     axis, result);
+        }
+
+        template <int N, int Axes, size_t... I>
+        inline bool TestCircleAxes(const FixedPolygon<N, Axes>& polygon, const Circle& circle, ContactInfo& result,
+                                   std::index_sequence<I...>) {
+            return (TestCircleAxis(polygon.vertices, circle, polygon.normals[I], result) && ...);
+        }
+
+        template <int N, size_t... I>
+        inline b2Vec2 ClosestPointOnBoundary(const b2Vec2 (&vertices)[N], const b2Vec2& point, std::index_sequence<I...>) {
+            float minDistSq = std::numeric_limits<float>::max();
+            b2Vec2 closest = vertices[0];
+            auto visit = [&](const b2Vec2& p1, const b2Vec2& p2) {
+                b2Vec2 pointOnEdge = GetClosestPointOnEdge(point, p1, p2);
+                float distSq = (point - pointOnEdge).LengthSquared();
+                if (distSq < minDistSq) {
+                    minDistSq = distSq;
+                    closest = pointOnEdge;
+                }
+            };
+            (visit(vertices[I], vertices[(I + 1) % N]), ...);
+            return closest;
+        }
+    }
+
+    template <int N, int AxesA, int M, int AxesB>
+    ContactInfo CheckPolygonToPolygon(const FixedPolygon<N, AxesA>& a, const FixedPolygon<M, AxesB>& b) {
+        ContactInfo result;
+        result.depth = std::numeric_limits<float>::max();
+
+        if (!Detail::TestPolygonAxes(a.vertices, b.vertices, a.normals, result, std::make_index_sequence<AxesA>()) ||
+            !Detail::TestPolygonAxes(a.vertices, b.vertices, b.normals, result, std::make_index_sequence<AxesB>())) {
+            return result;
+        }
+
+        if (b2Dot(b.GetCenter() - a.GetCenter(), result.normal) < 0.0f) {
+            result.normal = -result.normal;
+        }
+
+        result.hasCollision = true;
+        return result;
+    }
+
+    template <int N, int Axes>
+    ContactInfo CheckCircleToPolygon(const Circle& circle, const FixedPolygon<N, Axes>& polygon) {
+        ContactInfo result;
+        result.depth = std::numeric_limits<float>::max();
+
+        if (!Detail::TestCircleAxes(polygon, circle, result, std::make_index_sequence<Axes>())) {
+            return result;
+        }
+
+        b2Vec2 closestPoint = Detail::ClosestPointOnBoundary(polygon.vertices, circle.center, std::make_index_sequence<N>());
+        b2Vec2 axis = circle.center - closestPoint;
+        float distSq = axis.LengthSquared();
+
+        if (distSq > 1e-6f) {
+            axis = (1.0f / std::sqrt(distSq)) * axis;
+            if (!Detail::TestCircleAxis(polygon.vertices, circle, axis, result)) {
+                return result;
+            }
+        }
+
+        if (b2Dot(circle.center - polygon.GetCenter(), result.normal) < 0.0f) {
+            result.normal = -result.normal;
+        }
+
+        result.hasCollision = true;
+        result.contactPoint = closestPoint;
+        return result;
+    }
+}
+
 #endif
\ No newline at end of file
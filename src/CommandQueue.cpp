@@ -0,0 +1,62 @@
+#include "CommandQueue.h"
+
+CommandQueue::CommandQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+
+    m_cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool CommandQueue::Enqueue(const PhysicsCommand& command) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &m_cells[pos & m_mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // Celda libre en esta vuelta: reclamarla
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // El consumidor aún no ha liberado la celda de la vuelta anterior
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->command = command;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    m_enqueued.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+BodyHandle CommandQueue::AllocateHandle() {
+    BodyHandle handle;
+    handle.id = m_nextHandle.fetch_add(1, std::memory_order_relaxed);
+    return handle;
+}
+
+bool CommandQueue::Dequeue(PhysicsCommand& command) {
+    Cell& cell = m_cells[m_dequeuePos & m_mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    // La celda siguiente en orden aún no está publicada: parar aquí para
+    // conservar el orden aunque haya celdas posteriores ya escritas
+    if (sequence != m_dequeuePos + 1) {
+        return false;
+    }
+
+    command = cell.command;
+    cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
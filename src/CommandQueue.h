@@ -0,0 +1,115 @@
+//
+// Cola de mutaciones del mundo que pueden encolarse desde cualquier hilo.
+//
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <box2d/box2d.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Referencia opaca a un cuerpo; vale antes de que el cuerpo exista (se
+// obtiene al encolar su creación) y no se reutiliza
+struct BodyHandle {
+    uint64_t id = 0;
+
+    bool IsValid() const { return id != 0; }
+    bool operator==(const BodyHandle& other) const { return id == other.id; }
+    bool operator!=(const BodyHandle& other) const { return id != other.id; }
+};
+
+// Descripción de un cuerpo de un solo fixture, copiable sin asignar memoria
+struct BodySpawn {
+    enum ShapeType : uint8_t {
+        e_circle,
+        e_box,
+        e_polygon
+    };
+
+    b2BodyType type = b2_dynamicBody;
+    b2Vec2 position = b2Vec2(0.0f, 0.0f);
+    float angle = 0.0f;
+    b2Vec2 linearVelocity = b2Vec2(0.0f, 0.0f);
+    float angularVelocity = 0.0f;
+    bool bullet = false;
+
+    ShapeType shape = e_circle;
+    float radius = 0.5f;                          // e_circle
+    b2Vec2 halfExtents = b2Vec2(0.5f, 0.5f);      // e_box
+    b2Vec2 vertices[b2_maxPolygonVertices];       // e_polygon
+    int32 vertexCount = 0;
+
+    float density = 1.0f;
+    float friction = 0.3f;
+    float restitution = 0.1f;
+    uint16_t categoryBits = 0x0001;
+    uint16_t maskBits = 0xFFFF;
+};
+
+struct PhysicsCommand {
+    enum Type : uint8_t {
+        e_createBody,
+        e_destroyBody,
+        e_setLinearVelocity,
+        e_applyLinearImpulse,
+        e_setCollisionFilter
+    };
+
+    Type type = e_destroyBody;
+    BodyHandle handle;
+    b2Vec2 vector = b2Vec2(0.0f, 0.0f); // Velocidad o impulso
+    uint16_t categoryBits = 0;
+    uint16_t maskBits = 0;
+    BodySpawn spawn;
+};
+
+struct CommandStats {
+    uint64_t enqueued = 0;
+    uint64_t dropped = 0;  // Cola llena al encolar
+    uint64_t applied = 0;
+    uint64_t orphaned = 0; // El handle no tenía cuerpo (ya destruido o nunca creado)
+};
+
+// Cola MPSC acotada (ring de celdas con número de secuencia, al estilo de la
+// de Dmitry Vyukov). Todas las celdas se reservan al construir: encolar es un
+// CAS sobre la posición y una copia, sin bloqueos ni asignaciones. Si la cola
+// está llena, Enqueue falla en lugar de esperar.
+//
+// Solo un hilo (el de Update) puede llamar a Dequeue.
+class CommandQueue {
+public:
+    explicit CommandQueue(size_t capacity = 4096);
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // Seguros desde cualquier hilo
+    bool Enqueue(const PhysicsCommand& command);
+    BodyHandle AllocateHandle();
+
+    bool Dequeue(PhysicsCommand& command);
+
+    size_t GetCapacity() const { return m_mask + 1; }
+    uint64_t GetEnqueuedCount() const { return m_enqueued.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        PhysicsCommand command;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;
+
+    std::atomic<uint64_t> m_nextHandle{1};
+    std::atomic<uint64_t> m_enqueued{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+#endif //COMMANDQUEUE_H
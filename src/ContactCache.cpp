@@ -0,0 +1,105 @@
+#include "ContactCache.h"
+#include <algorithm>
+
+namespace {
+    // Carga máxima del 50%: con sondeo lineal las búsquedas siguen siendo cortas
+    const size_t kMinSlots = 64;
+
+    size_t SlotsFor(size_t count) {
+        size_t slots = kMinSlots;
+        while (slots < 2 * count) {
+            slots *= 2;
+        }
+        return slots;
+    }
+}
+
+ContactCache::ContactCache()
+    : m_mask(0)
+    , m_count(0) {
+    Rehash(kMinSlots);
+}
+
+void ContactCache::Reserve(size_t count) {
+    size_t slots = SlotsFor(count);
+    if (slots > m_keys.size()) {
+        Rehash(slots);
+    }
+}
+
+void ContactCache::Clear() {
+    if (m_count > 0) {
+        std::fill(m_keys.begin(), m_keys.end(), nullptr);
+        m_count = 0;
+    }
+}
+
+size_t ContactCache::HomeSlot(const b2Contact* contact) const {
+    // Hash de Fibonacci sobre la dirección; los bits bajos son siempre cero
+    uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(contact)) >> 4;
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & m_mask;
+}
+
+const ContactInfo* ContactCache::Find(const b2Contact* contact) const {
+    for (size_t i = HomeSlot(contact); m_keys[i]; i = (i + 1) & m_mask) {
+        if (m_keys[i] == contact) {
+            return &m_values[i];
+        }
+    }
+    return nullptr;
+}
+
+void ContactCache::Insert(b2Contact* contact, const ContactInfo& info) {
+    if (2 * (m_count + 1) > m_keys.size()) {
+        Rehash(2 * m_keys.size());
+    }
+
+    size_t i = HomeSlot(contact);
+    while (m_keys[i] && m_keys[i] != contact) {
+        i = (i + 1) & m_mask;
+    }
+    if (!m_keys[i]) {
+        m_keys[i] = contact;
+        ++m_count;
+    }
+    m_values[i] = info;
+}
+
+void ContactCache::Erase(const b2Contact* contact) {
+    size_t hole = HomeSlot(contact);
+    while (m_keys[hole] != contact) {
+        if (!m_keys[hole]) {
+            return;
+        }
+        hole = (hole + 1) & m_mask;
+    }
+
+    // Borrado hacia atrás: se adelantan las entradas de la misma racha que
+    // ya no encontrarían su sitio si quedara un hueco delante
+    for (size_t i = (hole + 1) & m_mask; m_keys[i]; i = (i + 1) & m_mask) {
+        size_t home = HomeSlot(m_keys[i]);
+        bool reachable = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!reachable) {
+            m_keys[hole] = m_keys[i];
+            m_values[hole] = m_values[i];
+            hole = i;
+        }
+    }
+    m_keys[hole] = nullptr;
+    --m_count;
+}
+
+void ContactCache::Rehash(size_t slots) {
+    std::vector<b2Contact*> keys(slots, nullptr);
+    std::vector<ContactInfo> values(slots);
+    keys.swap(m_keys);
+    values.swap(m_values);
+    m_mask = slots - 1;
+    m_count = 0;
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i]) {
+            Insert(keys[i], values[i]);
+        }
+    }
+}
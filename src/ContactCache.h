@@ -0,0 +1,52 @@
+//
+// Resultados de la detección personalizada por b2Contact, sin nodos sueltos.
+//
+#ifndef CONTACTCACHE_H
+#define CONTACTCACHE_H
+
+#include "Collision.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class b2Contact;
+
+// Tabla hash de direccionamiento abierto (sondeo lineal) sobre dos vectores.
+// Clear no libera nada y Erase compacta el hueco en el sitio, así que una vez
+// reservada la capacidad para los contactos del mundo, llenarla y vaciarla en
+// cada Update no asigna memoria. Solo crece si se supera lo reservado.
+class ContactCache {
+public:
+    ContactCache();
+
+    // Capacidad para count entradas sin crecer
+    void Reserve(size_t count);
+    void Clear();
+
+    // nullptr si el contacto no está
+    const ContactInfo* Find(const b2Contact* contact) const;
+    void Insert(b2Contact* contact, const ContactInfo& info);
+    void Erase(const b2Contact* contact);
+
+    size_t GetCount() const { return m_count; }
+
+    template <class Function>
+    void ForEach(Function function) const {
+        for (size_t i = 0; i < m_keys.size(); ++i) {
+            if (m_keys[i]) {
+                function(m_keys[i], m_values[i]);
+            }
+        }
+    }
+
+private:
+    size_t HomeSlot(const b2Contact* contact) const;
+    void Rehash(size_t slots);
+
+    std::vector<b2Contact*> m_keys;   // nullptr = libre
+    std::vector<ContactInfo> m_values;
+    size_t m_mask;
+    size_t m_count;
+};
+
+#endif //CONTACTCACHE_H
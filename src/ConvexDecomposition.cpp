@@ -0,0 +1,303 @@
+#include "ConvexDecomposition.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Distancia bajo la que Box2D suelda vértices; por debajo, un vértice se
+    // considera duplicado o colineal
+    const float kWeldDistance = 0.5f * b2_linearSlop;
+
+    float Cross(const b2Vec2& o, const b2Vec2& a, const b2Vec2& b) {
+        return b2Cross(a - o, b - o);
+    }
+
+    // ¿Está b alineado con a-c (a menos de kWeldDistance de la recta)?
+    bool IsCollinear(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c) {
+        float length = (c - a).Length();
+        return std::abs(Cross(a, b, c)) <= kWeldDistance * std::max(length, b2_epsilon);
+    }
+
+    float SignedArea(const std::vector<b2Vec2>& points) {
+        float area = 0.0f;
+        for (size_t i = 0; i < points.size(); ++i) {
+            area += b2Cross(points[i], points[(i + 1) % points.size()]);
+        }
+        return 0.5f * area;
+    }
+
+    // Quita duplicados y vértices colineales
+    void Simplify(std::vector<b2Vec2>& points) {
+        bool changed = true;
+        while (changed && points.size() >= 3) {
+            changed = false;
+            for (size_t i = 0; i < points.size() && points.size() >= 3;) {
+                size_t n = points.size();
+                const b2Vec2& prev = points[(i + n - 1) % n];
+                const b2Vec2& next = points[(i + 1) % n];
+                if ((points[i] - next).LengthSquared() < kWeldDistance * kWeldDistance ||
+                    IsCollinear(prev, points[i], next)) {
+                    points.erase(points.begin() + i);
+                    changed = true;
+                } else {
+                    ++i;
+                }
+            }
+        }
+    }
+
+    int Orientation(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c) {
+        float cross = Cross(a, b, c);
+        return cross > 0.0f ? 1 : (cross < 0.0f ? -1 : 0);
+    }
+
+    bool OnSegment(const b2Vec2& a, const b2Vec2& b, const b2Vec2& p) {
+        return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+               std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+    }
+
+    bool SegmentsIntersect(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c, const b2Vec2& d) {
+        int o1 = Orientation(a, b, c);
+        int o2 = Orientation(a, b, d);
+        int o3 = Orientation(c, d, a);
+        int o4 = Orientation(c, d, b);
+        if (o1 != o2 && o3 != o4) {
+            return true;
+        }
+        return (o1 == 0 && OnSegment(a, b, c)) || (o2 == 0 && OnSegment(a, b, d)) ||
+               (o3 == 0 && OnSegment(c, d, a)) || (o4 == 0 && OnSegment(c, d, b));
+    }
+
+    // Ninguna arista cruza a otra que no sea su vecina
+    bool IsSimple(const std::vector<b2Vec2>& points) {
+        size_t n = points.size();
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 2; j < n; ++j) {
+                if (i == 0 && j == n - 1) {
+                    continue;
+                }
+                if (SegmentsIntersect(points[i], points[(i + 1) % n], points[j], points[(j + 1) % n])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool PointInTriangle(const b2Vec2& p, const b2Vec2& a, const b2Vec2& b, const b2Vec2& c) {
+        // Incluye el borde: una diagonal que pase por otro vértice no vale
+        return Cross(a, b, p) >= 0.0f && Cross(b, c, p) >= 0.0f && Cross(c, a, p) >= 0.0f;
+    }
+
+    // Recorte de orejas sobre un polígono CCW; devuelve triángulos de índices
+    bool Triangulate(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& triangles) {
+        std::vector<int> remaining(points.size());
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            remaining[i] = static_cast<int>(i);
+        }
+
+        while (remaining.size() > 3) {
+            size_t m = remaining.size();
+            bool clipped = false;
+
+            for (size_t k = 0; k < m && !clipped; ++k) {
+                int prev = remaining[(k + m - 1) % m];
+                int cur = remaining[k];
+                int next = remaining[(k + 1) % m];
+                if (Cross(points[prev], points[cur], points[next]) <= 0.0f ||
+                    IsCollinear(points[prev], points[cur], points[next])) {
+                    continue; // Reflejo o plano
+                }
+
+                bool isEar = true;
+                for (int other : remaining) {
+                    if (other != prev && other != cur && other != next &&
+                        PointInTriangle(points[other], points[prev], points[cur], points[next])) {
+                        isEar = false;
+                        break;
+                    }
+                }
+                if (isEar) {
+                    triangles.push_back({ prev, cur, next });
+                    remaining.erase(remaining.begin() + k);
+                    clipped = true;
+                }
+            }
+
+            if (!clipped) {
+                // Solo quedan vértices planos: quitar uno sin emitir triángulo
+                for (size_t k = 0; k < m && !clipped; ++k) {
+                    if (IsCollinear(points[remaining[(k + m - 1) % m]], points[remaining[k]], points[remaining[(k + 1) % m]])) {
+                        remaining.erase(remaining.begin() + k);
+                        clipped = true;
+                    }
+                }
+                if (!clipped) {
+                    return false;
+                }
+            }
+        }
+
+        if (!IsCollinear(points[remaining[0]], points[remaining[1]], points[remaining[2]])) {
+            triangles.push_back(remaining);
+        }
+        return true;
+    }
+
+    // Vértices que cuentan para Box2D (los colineales desaparecen en Set)
+    int32 CornerCount(const std::vector<b2Vec2>& points, const std::vector<int>& piece) {
+        int32 corners = 0;
+        size_t n = piece.size();
+        for (size_t i = 0; i < n; ++i) {
+            if (!IsCollinear(points[piece[(i + n - 1) % n]], points[piece[i]], points[piece[(i + 1) % n]])) {
+                ++corners;
+            }
+        }
+        return corners;
+    }
+
+    bool IsConvex(const std::vector<b2Vec2>& points, const std::vector<int>& piece) {
+        size_t n = piece.size();
+        for (size_t i = 0; i < n; ++i) {
+            const b2Vec2& prev = points[piece[(i + n - 1) % n]];
+            const b2Vec2& cur = points[piece[i]];
+            const b2Vec2& next = points[piece[(i + 1) % n]];
+            if (Cross(prev, cur, next) < 0.0f && !IsCollinear(prev, cur, next)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Une a y b por una arista compartida (u->v en a, v->u en b). Devuelve
+    // false si no comparten ninguna.
+    bool MergeAlongSharedEdge(const std::vector<int>& a, const std::vector<int>& b, std::vector<int>& merged) {
+        size_t na = a.size();
+        size_t nb = b.size();
+        for (size_t i = 0; i < na; ++i) {
+            int u = a[i];
+            int v = a[(i + 1) % na];
+            for (size_t j = 0; j < nb; ++j) {
+                if (b[j] != v || b[(j + 1) % nb] != u) {
+                    continue;
+                }
+                merged.clear();
+                // Todo a empezando en v y acabando en u, luego b entre u y v
+                for (size_t k = 0; k < na; ++k) {
+                    merged.push_back(a[(i + 1 + k) % na]);
+                }
+                for (size_t k = 2; k < nb; ++k) {
+                    merged.push_back(b[(j + k) % nb]);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Hertel–Mehlhorn: quitar diagonales mientras la unión siga siendo convexa
+    void MergePieces(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& pieces) {
+        std::vector<int> merged;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t a = 0; a < pieces.size() && !changed; ++a) {
+                for (size_t b = a + 1; b < pieces.size() && !changed; ++b) {
+                    if (!MergeAlongSharedEdge(pieces[a], pieces[b], merged) ||
+                        CornerCount(points, merged) > b2_maxPolygonVertices || !IsConvex(points, merged)) {
+                        continue;
+                    }
+                    pieces[a] = merged;
+                    pieces.erase(pieces.begin() + b);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    uint64_t HashVertices(const b2Vec2* vertices, int32 count) {
+        // FNV-1a sobre los bytes de las coordenadas
+        uint64_t hash = 1469598103934665603ull;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vertices);
+        for (size_t i = 0; i < static_cast<size_t>(count) * sizeof(b2Vec2); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+bool ConvexDecomposer::DecomposeUncached(const b2Vec2* vertices, int32 count, std::vector<ConvexPiece>& pieces) {
+    pieces.clear();
+
+    std::vector<b2Vec2> points(vertices, vertices + std::max<int32>(count, 0));
+    Simplify(points);
+    if (points.size() < 3 || !IsSimple(points)) {
+        return false;
+    }
+    if (SignedArea(points) < 0.0f) {
+        std::reverse(points.begin(), points.end());
+    }
+
+    std::vector<std::vector<int>> indexPieces;
+    if (!Triangulate(points, indexPieces)) {
+        return false;
+    }
+    MergePieces(points, indexPieces);
+
+    for (const std::vector<int>& piece : indexPieces) {
+        ConvexPiece out;
+        size_t n = piece.size();
+        for (size_t i = 0; i < n; ++i) {
+            const b2Vec2& cur = points[piece[i]];
+            if (!IsCollinear(points[piece[(i + n - 1) % n]], cur, points[piece[(i + 1) % n]])) {
+                out.vertices[out.count++] = cur;
+            }
+        }
+        if (out.count >= 3) {
+            pieces.push_back(out);
+        }
+    }
+    return !pieces.empty();
+}
+
+const std::vector<ConvexPiece>* ConvexDecomposer::Decompose(const b2Vec2* vertices, int32 count) {
+    if (count < 3) {
+        return nullptr;
+    }
+
+    const uint64_t hash = HashVertices(vertices, count);
+
+    auto range = m_cache.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const CacheEntry& entry = it->second;
+        if (entry.source.size() == static_cast<size_t>(count) &&
+            std::memcmp(entry.source.data(), vertices, count * sizeof(b2Vec2)) == 0) {
+            ++m_hits;
+            return entry.valid ? &entry.pieces : nullptr;
+        }
+    }
+
+    ++m_misses;
+    CacheEntry entry;
+    entry.source.assign(vertices, vertices + count);
+    entry.valid = DecomposeUncached(vertices, count, entry.pieces);
+    if (!entry.valid) {
+        std::cerr << "[ConvexDecomposer] Polígono no simple o degenerado (" << count << " vértices)" << std::endl;
+    }
+
+    auto it = m_cache.emplace(hash, std::move(entry));
+    return it->second.valid ? &it->second.pieces : nullptr;
+}
+
+void ConvexDecomposer::ClearCache() {
+    m_cache.clear();
+}
+
+DecompositionStats ConvexDecomposer::GetStats() const {
+    DecompositionStats stats;
+    stats.cacheHits = m_hits;
+    stats.cacheMisses = m_misses;
+    stats.cachedShapes = m_cache.size();
+    return stats;
+}
@@ -0,0 +1,56 @@
+//
+// Descomposición de polígonos cóncavos en piezas convexas para Box2D.
+//
+#ifndef CONVEXDECOMPOSITION_H
+#define CONVEXDECOMPOSITION_H
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Pieza convexa lista para b2PolygonShape::Set (CCW, sin vértices colineales)
+struct ConvexPiece {
+    b2Vec2 vertices[b2_maxPolygonVertices];
+    int32 count = 0;
+};
+
+struct DecompositionStats {
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+    size_t cachedShapes = 0;
+};
+
+// Hertel–Mehlhorn: triangulación por recorte de orejas y después se eliminan
+// las diagonales que no hacen falta (se unen dos piezas vecinas mientras el
+// resultado siga siendo convexo y quepa en b2_maxPolygonVertices). Da como
+// mucho cuatro veces el mínimo de piezas, y en la práctica muy cerca.
+//
+// Los resultados se guardan por hash del contenido (los vértices exactos),
+// así que una forma repetida o una recarga del nivel no vuelve a
+// descomponer. La caché vive en memoria mientras viva el objeto.
+class ConvexDecomposer {
+public:
+    // Piezas de un polígono simple en cualquier orientación, o nullptr si se
+    // cruza consigo mismo o es degenerado. El puntero vale hasta ClearCache.
+    const std::vector<ConvexPiece>* Decompose(const b2Vec2* vertices, int32 count);
+
+    void ClearCache();
+    DecompositionStats GetStats() const;
+
+    // Sin caché
+    static bool DecomposeUncached(const b2Vec2* vertices, int32 count, std::vector<ConvexPiece>& pieces);
+
+private:
+    struct CacheEntry {
+        std::vector<b2Vec2> source; // Para descartar colisiones de hash
+        std::vector<ConvexPiece> pieces;
+        bool valid;
+    };
+
+    std::unordered_multimap<uint64_t, CacheEntry> m_cache;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
+
+#endif //CONVEXDECOMPOSITION_H
@@ -0,0 +1,110 @@
+#include "DebugDraw.h"
+#include <cmath>
+
+namespace {
+    const int kCircleSegments = 16;
+    const float kFillAlpha = 0.5f;
+    const float kAxisLength = 0.4f; // metros
+}
+
+SFMLDebugDraw::SFMLDebugDraw(float pixelsPerMeter)
+    : m_scale(pixelsPerMeter)
+    , m_lines(sf::Lines)
+    , m_triangles(sf::Triangles) {
+}
+
+sf::Color SFMLDebugDraw::ToColor(const b2Color& color, float alphaScale) {
+    return sf::Color(
+        static_cast<sf::Uint8>(255.f * color.r),
+        static_cast<sf::Uint8>(255.f * color.g),
+        static_cast<sf::Uint8>(255.f * color.b),
+        static_cast<sf::Uint8>(255.f * color.a * alphaScale)
+    );
+}
+
+void SFMLDebugDraw::AddLine(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Color& color) {
+    m_lines.append(sf::Vertex(a, color));
+    m_lines.append(sf::Vertex(b, color));
+}
+
+void SFMLDebugDraw::AddTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Color& color) {
+    m_triangles.append(sf::Vertex(a, color));
+    m_triangles.append(sf::Vertex(b, color));
+    m_triangles.append(sf::Vertex(c, color));
+}
+
+void SFMLDebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
+    sf::Color c = ToColor(color);
+    for (int32 i = 0; i < vertexCount; ++i) {
+        AddLine(ToPixels(vertices[i]), ToPixels(vertices[(i + 1) % vertexCount]), c);
+    }
+}
+
+void SFMLDebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
+    sf::Color fill = ToColor(color, kFillAlpha);
+    sf::Vector2f origin = ToPixels(vertices[0]);
+    for (int32 i = 1; i + 1 < vertexCount; ++i) {
+        AddTriangle(origin, ToPixels(vertices[i]), ToPixels(vertices[i + 1]), fill);
+    }
+    DrawPolygon(vertices, vertexCount, color);
+}
+
+void SFMLDebugDraw::DrawCircle(const b2Vec2& center, float radius, const b2Color& color) {
+    sf::Color c = ToColor(color);
+    const float step = 2.0f * b2_pi / kCircleSegments;
+    b2Vec2 prev = center + b2Vec2(radius, 0.0f);
+    for (int i = 1; i <= kCircleSegments; ++i) {
+        b2Vec2 next = center + b2Vec2(radius * std::cos(i * step), radius * std::sin(i * step));
+        AddLine(ToPixels(prev), ToPixels(next), c);
+        prev = next;
+    }
+}
+
+void SFMLDebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) {
+    sf::Color fill = ToColor(color, kFillAlpha);
+    const float step = 2.0f * b2_pi / kCircleSegments;
+    sf::Vector2f c = ToPixels(center);
+    sf::Vector2f prev = ToPixels(center + b2Vec2(radius, 0.0f));
+    for (int i = 1; i <= kCircleSegments; ++i) {
+        sf::Vector2f next = ToPixels(center + b2Vec2(radius * std::cos(i * step), radius * std::sin(i * step)));
+        AddTriangle(c, prev, next, fill);
+        prev = next;
+    }
+    DrawCircle(center, radius, color);
+    AddLine(c, ToPixels(center + radius * axis), ToColor(color));
+}
+
+void SFMLDebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) {
+    AddLine(ToPixels(p1), ToPixels(p2), ToColor(color));
+}
+
+void SFMLDebugDraw::DrawTransform(const b2Transform& xf) {
+    b2Vec2 xAxis = xf.p + kAxisLength * b2Vec2(xf.q.c, xf.q.s);
+    b2Vec2 yAxis = xf.p + kAxisLength * b2Vec2(-xf.q.s, xf.q.c);
+    AddLine(ToPixels(xf.p), ToPixels(xAxis), sf::Color::Red);
+    AddLine(ToPixels(xf.p), ToPixels(yAxis), sf::Color::Green);
+}
+
+void SFMLDebugDraw::DrawPoint(const b2Vec2& p, float size, const b2Color& color) {
+    // size viene en píxeles, como en el testbed de Box2D
+    sf::Color c = ToColor(color);
+    sf::Vector2f center = ToPixels(p);
+    float h = 0.5f * size;
+    sf::Vector2f a(center.x - h, center.y - h);
+    sf::Vector2f b(center.x + h, center.y - h);
+    sf::Vector2f d(center.x + h, center.y + h);
+    sf::Vector2f e(center.x - h, center.y + h);
+    AddTriangle(a, b, d, c);
+    AddTriangle(a, d, e, c);
+}
+
+void SFMLDebugDraw::Flush(sf::RenderTarget& target) {
+    if (m_triangles.getVertexCount() > 0) {
+        target.draw(m_triangles);
+    }
+    if (m_lines.getVertexCount() > 0) {
+        target.draw(m_lines);
+    }
+    m_triangles.clear();
+    m_lines.clear();
+}
@@ -0,0 +1,40 @@
+//
+// Backend de b2Draw para SFML que agrupa todas las primitivas por tipo.
+//
+#ifndef DEBUGDRAW_H
+#define DEBUGDRAW_H
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+
+// Acumula líneas y triángulos en un sf::VertexArray por tipo de primitiva y
+// los dibuja con Flush, una llamada a draw por array y por fotograma.
+// Los arrays se vacían sin liberar memoria, así que tras el primer fotograma
+// no hay asignaciones.
+class SFMLDebugDraw : public b2Draw {
+public:
+    explicit SFMLDebugDraw(float pixelsPerMeter);
+
+    void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+    void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+    void DrawCircle(const b2Vec2& center, float radius, const b2Color& color) override;
+    void DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) override;
+    void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
+    void DrawTransform(const b2Transform& xf) override;
+    void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
+
+    void Flush(sf::RenderTarget& target);
+
+private:
+    sf::Vector2f ToPixels(const b2Vec2& v) const { return sf::Vector2f(v.x * m_scale, v.y * m_scale); }
+    static sf::Color ToColor(const b2Color& color, float alphaScale = 1.0f);
+
+    void AddLine(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Color& color);
+    void AddTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Color& color);
+
+    float m_scale;
+    sf::VertexArray m_lines;
+    sf::VertexArray m_triangles;
+};
+
+#endif //DEBUGDRAW_H
@@ -0,0 +1,295 @@
+#include "ForceField.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    size_t RoundUpToLanes(size_t n) {
+        return (n + 3) & ~static_cast<size_t>(3);
+    }
+
+    // Parámetros de un campo ya preparados para el bucle
+    struct FieldKernel {
+        float cx, cy;
+        float invX, invY;  // 1/radio (círculo) o 1/semiejes (caja)
+        bool isBox;
+        float radial;
+        float dirX, dirY;
+        ForceField::Falloff falloff;
+        bool massScaled;
+        int32_t mask;
+    };
+
+    FieldKernel MakeKernel(const ForceField& field) {
+        FieldKernel k;
+        k.cx = field.center.x;
+        k.cy = field.center.y;
+        k.isBox = field.shape == ForceField::e_box;
+        k.invX = 1.0f / std::max(k.isBox ? field.halfExtents.x : field.radius, b2_epsilon);
+        k.invY = k.isBox ? 1.0f / std::max(field.halfExtents.y, b2_epsilon) : k.invX;
+        k.radial = field.radialStrength;
+        k.dirX = field.directional.x;
+        k.dirY = field.directional.y;
+        k.falloff = field.falloff;
+        k.massScaled = field.massScaled;
+        k.mask = field.categoryMask;
+        return k;
+    }
+
+    void AccumulateScalar(const FieldKernel& k, size_t begin, size_t end, const float* px, const float* py,
+                          const float* mass, const int32_t* category, float* outX, float* outY) {
+        for (size_t i = begin; i < end; ++i) {
+            float dx = px[i] - k.cx;
+            float dy = py[i] - k.cy;
+            float dist = std::sqrt(dx * dx + dy * dy);
+            float s = k.isBox ? std::max(std::abs(dx) * k.invX, std::abs(dy) * k.invY) : dist * k.invX;
+            if (s > 1.0f || (category[i] & k.mask) == 0) {
+                continue;
+            }
+
+            float t = 1.0f - s;
+            float w = k.falloff == ForceField::e_falloffNone ? 1.0f
+                    : k.falloff == ForceField::e_falloffLinear ? t : t * t;
+            if (k.massScaled) {
+                w *= mass[i];
+            }
+
+            float invDist = dist > b2_epsilon ? 1.0f / dist : 0.0f;
+            outX[i] += w * (k.radial * dx * invDist + k.dirX);
+            outY[i] += w * (k.radial * dy * invDist + k.dirY);
+        }
+    }
+}
+
+b2AABB ForceField::GetBounds() const {
+    b2Vec2 extent = shape == e_box ? halfExtents : b2Vec2(radius, radius);
+    b2AABB bounds;
+    bounds.lowerBound = center - extent;
+    bounds.upperBound = center + extent;
+    return bounds;
+}
+
+ForceField ForceField::Explosion(const b2Vec2& center, float radius, float impulse) {
+    ForceField field;
+    field.shape = e_circle;
+    field.center = center;
+    field.radius = radius;
+    field.radialStrength = impulse;
+    field.falloff = e_falloffLinear;
+    field.impulse = true;
+    return field;
+}
+
+ForceField ForceField::Wind(const b2AABB& area, const b2Vec2& force) {
+    ForceField field;
+    field.shape = e_box;
+    field.center = area.GetCenter();
+    field.halfExtents = area.GetExtents();
+    field.directional = force;
+    field.falloff = e_falloffNone;
+    return field;
+}
+
+ForceField ForceField::GravityWell(const b2Vec2& center, float radius, float acceleration) {
+    ForceField field;
+    field.shape = e_circle;
+    field.center = center;
+    field.radius = radius;
+    field.radialStrength = -acceleration;
+    field.falloff = e_falloffLinear;
+    field.massScaled = true;
+    return field;
+}
+
+ForceFieldSystem::ForceFieldSystem()
+    : m_nextId(1)
+    , m_wakeThreshold(0.05f) {
+    m_gatherCallback.bodies = &m_bodies;
+}
+
+ForceFieldId ForceFieldSystem::Add(const ForceField& field) {
+    ForceFieldId id = m_nextId++;
+    m_fields.push_back({ id, field, 0.0f });
+    return id;
+}
+
+bool ForceFieldSystem::Remove(ForceFieldId id) {
+    for (size_t i = 0; i < m_fields.size(); ++i) {
+        if (m_fields[i].id == id) {
+            m_fields[i] = m_fields.back();
+            m_fields.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+ForceField* ForceFieldSystem::Find(ForceFieldId id) {
+    for (Entry& entry : m_fields) {
+        if (entry.id == id) {
+            return &entry.field;
+        }
+    }
+    return nullptr;
+}
+
+void ForceFieldSystem::Apply(b2World* world, float deltaTime) {
+    m_stats = ForceFieldStats();
+    m_stats.activeFields = static_cast<int32_t>(m_fields.size());
+    if (m_fields.empty()) {
+        return;
+    }
+
+    Gather(world);
+    for (const Entry& entry : m_fields) {
+        Accumulate(entry.field);
+    }
+    ApplyToBodies(deltaTime);
+    Expire(deltaTime);
+}
+
+void ForceFieldSystem::Gather(b2World* world) {
+    m_bodies.clear();
+    for (const Entry& entry : m_fields) {
+        world->QueryAABB(&m_gatherCallback, entry.field.GetBounds());
+    }
+
+    std::sort(m_bodies.begin(), m_bodies.end());
+    m_bodies.erase(std::unique(m_bodies.begin(), m_bodies.end()), m_bodies.end());
+
+    const size_t count = m_bodies.size();
+    const size_t padded = RoundUpToLanes(count);
+    m_posX.assign(padded, 0.0f);
+    m_posY.assign(padded, 0.0f);
+    m_mass.assign(padded, 0.0f);
+    m_category.assign(padded, 0);
+    m_forceX.assign(padded, 0.0f);
+    m_forceY.assign(padded, 0.0f);
+    m_impulseX.assign(padded, 0.0f);
+    m_impulseY.assign(padded, 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        b2Body* body = m_bodies[i];
+        const b2Vec2& center = body->GetWorldCenter();
+        m_posX[i] = center.x;
+        m_posY[i] = center.y;
+        m_mass[i] = body->GetMass();
+
+        // Un cuerpo pertenece a todas las categorías de sus fixtures
+        int32_t category = 0;
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+            if (!fixture->IsSensor()) {
+                category |= fixture->GetFilterData().categoryBits;
+            }
+        }
+        m_category[i] = category;
+    }
+
+    m_stats.gatheredBodies = static_cast<int32_t>(count);
+}
+
+void ForceFieldSystem::Accumulate(const ForceField& field) {
+    const FieldKernel k = MakeKernel(field);
+    const size_t n = m_bodies.size();
+    float* outX = field.impulse ? m_impulseX.data() : m_forceX.data();
+    float* outY = field.impulse ? m_impulseY.data() : m_forceY.data();
+    const float* px = m_posX.data();
+    const float* py = m_posY.data();
+    const float* mass = m_mass.data();
+    const int32_t* category = m_category.data();
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 cx4 = _mm_set1_ps(k.cx);
+    const __m128 cy4 = _mm_set1_ps(k.cy);
+    const __m128 invX4 = _mm_set1_ps(k.invX);
+    const __m128 invY4 = _mm_set1_ps(k.invY);
+    const __m128 radial4 = _mm_set1_ps(k.radial);
+    const __m128 dirX4 = _mm_set1_ps(k.dirX);
+    const __m128 dirY4 = _mm_set1_ps(k.dirY);
+    const __m128 one4 = _mm_set1_ps(1.0f);
+    const __m128 zero4 = _mm_setzero_ps();
+    const __m128 eps4 = _mm_set1_ps(b2_epsilon);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128i mask4 = _mm_set1_epi32(k.mask);
+
+    // Los arrays están rellenados hasta múltiplo de 4 con categoría 0,
+    // así que el último grupo incompleto no aporta nada
+    for (; i < n; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), cx4);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), cy4);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 s = k.isBox
+            ? _mm_max_ps(_mm_mul_ps(_mm_and_ps(dx, absMask), invX4), _mm_mul_ps(_mm_and_ps(dy, absMask), invY4))
+            : _mm_mul_ps(dist, invX4);
+
+        // Peso: atenuación dentro del área y de la categoría correcta, 0 fuera
+        __m128 t = _mm_max_ps(_mm_sub_ps(one4, s), zero4);
+        __m128 w = k.falloff == ForceField::e_falloffNone ? one4
+                 : k.falloff == ForceField::e_falloffLinear ? t : _mm_mul_ps(t, t);
+        __m128i categories = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(category + i)), mask4);
+        __m128 inCategory = _mm_castsi128_ps(_mm_cmpeq_epi32(categories, _mm_setzero_si128()));
+        w = _mm_andnot_ps(inCategory, _mm_and_ps(w, _mm_cmple_ps(s, one4)));
+        if (k.massScaled) {
+            w = _mm_mul_ps(w, _mm_loadu_ps(mass + i));
+        }
+
+        // Dirección radial normalizada; 0 en el centro exacto
+        __m128 invDist = _mm_and_ps(_mm_div_ps(one4, _mm_max_ps(dist, eps4)), _mm_cmpgt_ps(dist, eps4));
+        __m128 fx = _mm_mul_ps(w, _mm_add_ps(_mm_mul_ps(radial4, _mm_mul_ps(dx, invDist)), dirX4));
+        __m128 fy = _mm_mul_ps(w, _mm_add_ps(_mm_mul_ps(radial4, _mm_mul_ps(dy, invDist)), dirY4));
+        _mm_storeu_ps(outX + i, _mm_add_ps(_mm_loadu_ps(outX + i), fx));
+        _mm_storeu_ps(outY + i, _mm_add_ps(_mm_loadu_ps(outY + i), fy));
+    }
+#endif
+    AccumulateScalar(k, i, n, px, py, mass, category, outX, outY);
+}
+
+void ForceFieldSystem::ApplyToBodies(float deltaTime) {
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        b2Vec2 force(m_forceX[i], m_forceY[i]);
+        b2Vec2 impulse(m_impulseX[i], m_impulseY[i]);
+        bool hasForce = force.x != 0.0f || force.y != 0.0f;
+        bool hasImpulse = impulse.x != 0.0f || impulse.y != 0.0f;
+        if (!hasForce && !hasImpulse) {
+            continue;
+        }
+
+        b2Body* body = m_bodies[i];
+        if (!body->IsAwake()) {
+            float deltaVelocity = (force.Length() * deltaTime + impulse.Length()) / std::max(m_mass[i], b2_epsilon);
+            if (deltaVelocity < m_wakeThreshold) {
+                ++m_stats.skippedSleeping;
+                continue;
+            }
+            ++m_stats.wokenBodies;
+        }
+
+        if (hasForce) {
+            body->ApplyForceToCenter(force, true);
+        }
+        if (hasImpulse) {
+            body->ApplyLinearImpulseToCenter(impulse, true);
+        }
+        ++m_stats.affectedBodies;
+    }
+}
+
+void ForceFieldSystem::Expire(float deltaTime) {
+    size_t i = 0;
+    while (i < m_fields.size()) {
+        Entry& entry = m_fields[i];
+        entry.age += deltaTime;
+        bool expired = entry.field.impulse ||
+                       (entry.field.duration >= 0.0f && entry.age >= entry.field.duration);
+        if (expired) {
+            m_fields[i] = m_fields.back();
+            m_fields.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
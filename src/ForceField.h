@@ -0,0 +1,126 @@
+//
+// Campos de fuerza por área: explosiones, zonas de viento y pozos de gravedad.
+//
+#ifndef FORCEFIELD_H
+#define FORCEFIELD_H
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <vector>
+
+using ForceFieldId = uint32_t;
+
+struct ForceField {
+    enum Shape : uint8_t {
+        e_circle,
+        e_box
+    };
+
+    // Atenuación según s = distancia normalizada al borde del área [0, 1]
+    enum Falloff : uint8_t {
+        e_falloffNone,      // 1
+        e_falloffLinear,    // 1 - s
+        e_falloffQuadratic  // (1 - s)^2
+    };
+
+    Shape shape = e_circle;
+    b2Vec2 center = b2Vec2(0.0f, 0.0f);
+    float radius = 1.0f;                       // e_circle
+    b2Vec2 halfExtents = b2Vec2(1.0f, 1.0f);   // e_box
+    float radialStrength = 0.0f;               // > 0 empuja hacia fuera, < 0 atrae
+    b2Vec2 directional = b2Vec2(0.0f, 0.0f);   // Componente fija (viento)
+    Falloff falloff = e_falloffLinear;
+    bool massScaled = false;  // Las intensidades son aceleraciones (m/s^2) en vez de fuerzas (N)
+    bool impulse = false;     // Se aplica una sola vez como impulso (N·s) y se retira
+    float duration = -1.0f;   // Segundos de vida; negativo = persistente
+    uint16_t categoryMask = 0xFFFF;
+
+    b2AABB GetBounds() const;
+
+    static ForceField Explosion(const b2Vec2& center, float radius, float impulse);
+    static ForceField Wind(const b2AABB& area, const b2Vec2& force);
+    static ForceField GravityWell(const b2Vec2& center, float radius, float acceleration);
+};
+
+struct ForceFieldStats {
+    int32_t activeFields = 0;
+    int32_t gatheredBodies = 0; // Cuerpos dinámicos distintos dentro de algún AABB
+    int32_t affectedBodies = 0; // Cuerpos a los que se aplicó algo
+    int32_t wokenBodies = 0;
+    int32_t skippedSleeping = 0; // Dormidos con fuerza por debajo del umbral
+};
+
+// Aplica todos los campos antes de cada Step en tres fases:
+//  1. Recogida: una QueryAABB por campo y deduplicación por cuerpo
+//     (ordenar + unique), de modo que un cuerpo con varios fixtures o dentro
+//     de varios campos aparece una sola vez.
+//  2. Cálculo: por cada campo, la fuerza sobre todos los cuerpos recogidos en
+//     SoA, de cuatro en cuatro con SSE2 si está disponible. Los cuerpos fuera
+//     del área o de otra categoría reciben peso cero.
+//  3. Aplicación: una llamada a Box2D por cuerpo con la suma de fuerzas y de
+//     impulsos. Un cuerpo dormido solo se despierta si el cambio de velocidad
+//     del paso supera el umbral; si no, se deja dormido.
+class ForceFieldSystem {
+public:
+    ForceFieldSystem();
+
+    ForceFieldId Add(const ForceField& field);
+    bool Remove(ForceFieldId id);
+    ForceField* Find(ForceFieldId id); // Para mover o cambiar un campo vivo
+    void Clear() { m_fields.clear(); }
+
+    size_t GetCount() const { return m_fields.size(); }
+    const ForceField& GetField(size_t index) const { return m_fields[index].field; }
+
+    // Cambio de velocidad (m/s) a partir del cual se despierta un cuerpo dormido
+    void SetWakeThreshold(float deltaVelocity) { m_wakeThreshold = deltaVelocity; }
+
+    void Apply(b2World* world, float deltaTime);
+
+    const ForceFieldStats& GetStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        ForceFieldId id;
+        ForceField field;
+        float age;
+    };
+
+    class GatherCallback : public b2QueryCallback {
+    public:
+        std::vector<b2Body*>* bodies = nullptr;
+
+        bool ReportFixture(b2Fixture* fixture) override {
+            b2Body* body = fixture->GetBody();
+            if (body->GetType() == b2_dynamicBody && !fixture->IsSensor()) {
+                bodies->push_back(body);
+            }
+            return true;
+        }
+    };
+
+    void Gather(b2World* world);
+    void Accumulate(const ForceField& field);
+    void ApplyToBodies(float deltaTime);
+    void Expire(float deltaTime);
+
+    std::vector<Entry> m_fields;
+    ForceFieldId m_nextId;
+    float m_wakeThreshold;
+
+    // SoA de los cuerpos recogidos, rellenado hasta múltiplo de 4
+    std::vector<b2Body*> m_bodies;
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_mass;
+    std::vector<int32_t> m_category;
+    std::vector<float> m_forceX;
+    std::vector<float> m_forceY;
+    std::vector<float> m_impulseX;
+    std::vector<float> m_impulseY;
+    GatherCallback m_gatherCallback;
+
+    ForceFieldStats m_stats;
+};
+
+#endif //FORCEFIELD_H
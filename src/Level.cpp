@@ -0,0 +1,148 @@
+#include "Level.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+    // El nivel se diseñó en píxeles sobre una pantalla de 1280x720 a 30 px/m
+    const float kDesignWidth = 1280.f;
+    const float kDesignHeight = 720.f;
+    const float kDesignScale = 30.f;
+
+    b2Body* CreateStaticBox(PhysicsWrapper& physics, float x, float y, float halfWidth, float halfHeight) {
+        b2BodyDef bodyDef;
+        bodyDef.position.Set(x / kDesignScale, y / kDesignScale);
+        b2Body* body = physics.CreateBody(&bodyDef);
+        b2PolygonShape box;
+        box.SetAsBox(halfWidth / kDesignScale, halfHeight / kDesignScale);
+        body->CreateFixture(&box, 0.0f);
+        return body;
+    }
+
+    b2Body* CreateDynamicBody(PhysicsWrapper& physics, float x, float y) {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position.Set(x / kDesignScale, y / kDesignScale);
+        return physics.CreateBody(&bodyDef);
+    }
+
+    // Tras crear sus fixtures: el cuerpo entra dormido en la lista del nivel
+    void AddSleeping(LevelBodies& level, b2Body* body) {
+        level.dynamicBodies.push_back(body);
+        body->SetSleepingAllowed(true);
+        body->SetAwake(false);
+    }
+
+    void CreateBox(PhysicsWrapper& physics, LevelBodies& level, float x, float y, float halfWidth, float halfHeight) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        physics.CreateBoxFixture(body, halfWidth / kDesignScale, halfHeight / kDesignScale, 1.0f);
+        AddSleeping(level, body);
+    }
+
+    void CreateTriangle(PhysicsWrapper& physics, LevelBodies& level, float x, float y, float size) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        b2PolygonShape triangleShape;
+        b2Vec2 vertices[3];
+        vertices[0].Set(0.0f, -size / kDesignScale);
+        vertices[1].Set(size / kDesignScale, size / kDesignScale);
+        vertices[2].Set(-size / kDesignScale, size / kDesignScale);
+        triangleShape.Set(vertices, 3);
+        physics.CreatePolygonFixture(body, &triangleShape, 1.5f);
+        AddSleeping(level, body);
+    }
+
+    void CreateHexagon(PhysicsWrapper& physics, LevelBodies& level, float x, float y, float radius) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        b2PolygonShape hexagonShape;
+        b2Vec2 vertices[6];
+        float angle = 0.0f;
+        for (int i = 0; i < 6; i++) {
+            vertices[i].Set(
+                (radius / kDesignScale) * std::cos(angle),
+                (radius / kDesignScale) * std::sin(angle)
+            );
+            angle += 60.0f * b2_pi / 180.0f; // 60 grados en radianes
+        }
+        hexagonShape.Set(vertices, 6);
+        physics.CreatePolygonFixture(body, &hexagonShape, 1.2f); // Densidad media
+        AddSleeping(level, body);
+    }
+
+    b2Body* CreateBall(PhysicsWrapper& physics, LevelBodies& level, float x, float y, float radius, float density) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        b2CircleShape circleShape;
+        circleShape.m_radius = radius / kDesignScale;
+        physics.CreateCircleFixture(body, &circleShape, density);
+        AddSleeping(level, body);
+        return body;
+    }
+}
+
+b2AABB GetLevelBounds() {
+    b2AABB bounds;
+    bounds.lowerBound.SetZero();
+    bounds.upperBound.Set(kDesignWidth / kDesignScale, kDesignHeight / kDesignScale);
+    return bounds;
+}
+
+LevelBodies BuildDefaultLevel(PhysicsWrapper& physics) {
+    LevelBodies level;
+
+    // --- Muros y suelo ---
+    level.ground = CreateStaticBox(physics, kDesignWidth / 2.f, kDesignHeight - 10.f, kDesignWidth / 2.f, 10.f);
+    level.leftWall = CreateStaticBox(physics, 10.f, kDesignHeight / 2.f, 10.f, kDesignHeight / 2.f);
+    level.rightWall = CreateStaticBox(physics, kDesignWidth - 10.f, kDesignHeight / 2.f, 10.f, kDesignHeight / 2.f);
+    level.ceiling = CreateStaticBox(physics, kDesignWidth / 2.f, 10.f, kDesignWidth / 2.f, 10.f);
+
+    // --- Estructura de obstáculos ---
+    CreateBox(physics, level, 950.f + 1 * 55.f, kDesignHeight - 35.f, 25.f, 25.f);
+    CreateBox(physics, level, 950.f + 2 * 55.f, kDesignHeight - 35.f, 25.f, 25.f);
+    CreateBox(physics, level, 977.f + 1 * 55.f, kDesignHeight - 85.f, 25.f, 25.f);
+    CreateBox(physics, level, 1032.f, kDesignHeight - 135.f, 80.f, 10.f);
+    CreateTriangle(physics, level, 1032.f, kDesignHeight - 185.f, 35.f);
+    CreateHexagon(physics, level, 950.f, kDesignHeight - 60.f, 30.f);
+
+    // --- Cerdo (objetivo) y pájaro ---
+    level.pig = CreateBall(physics, level, 1032.f, kDesignHeight - 105.f, 15.f, 0.5f);
+    level.bird = CreateBall(physics, level, 150.f, kDesignHeight - 100.f, 20.f, 2.0f);
+
+    return level;
+}
+
+void DestroyLevel(PhysicsWrapper& physics, LevelBodies& level) {
+    // Se vacía level primero: DestroyBody puede llamar a ForgetLevelBody
+    LevelBodies bodies = std::move(level);
+    level = LevelBodies();
+
+    for (b2Body* body : bodies.dynamicBodies) {
+        physics.DestroyBody(body);
+    }
+    physics.DestroyBody(bodies.ground);
+    physics.DestroyBody(bodies.leftWall);
+    physics.DestroyBody(bodies.rightWall);
+    physics.DestroyBody(bodies.ceiling);
+}
+
+void ForgetLevelBody(LevelBodies& level, const b2Body* body) {
+    b2Body** named[] = { &level.ground, &level.leftWall, &level.rightWall, &level.ceiling, &level.pig, &level.bird };
+    for (b2Body** slot : named) {
+        if (*slot == body) {
+            *slot = nullptr;
+        }
+    }
+    level.dynamicBodies.erase(std::remove(level.dynamicBodies.begin(), level.dynamicBodies.end(), body),
+                              level.dynamicBodies.end());
+}
+
+void LaunchBird(PhysicsWrapper& physics, const LevelBodies& level, const b2Vec2& velocity) {
+    if (!level.bird) {
+        return;
+    }
+    level.bird->SetAwake(true);
+    physics.SetBullet(level.bird, true);
+    level.bird->SetLinearVelocity(velocity);
+}
+
+bool IsLevelWon(const LevelBodies& level) {
+    return level.pig && level.pig->GetPosition().y > (kDesignHeight - 40.f) / kDesignScale;
+}
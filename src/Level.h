@@ -0,0 +1,47 @@
+//
+// Nivel por defecto, compartido por el juego y la simulación sin ventana.
+//
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "PhysicsWrapper.h"
+#include <vector>
+
+// Gravedad del nivel: el eje y crece hacia abajo, como en pantalla
+const float kLevelGravity = 9.8f;
+
+struct LevelBodies {
+    b2Body* ground = nullptr;
+    b2Body* leftWall = nullptr;
+    b2Body* rightWall = nullptr;
+    b2Body* ceiling = nullptr;
+    b2Body* pig = nullptr;  // Objetivo
+    b2Body* bird = nullptr;
+
+    // Cuerpos dinámicos en orden de creación: obstáculos, cerdo y pájaro.
+    // El orden es siempre el mismo, así que el índice de un cuerpo no cambia
+    // entre reinicios.
+    std::vector<b2Body*> dynamicBodies;
+};
+
+// Rectángulo que ocupa el nivel, en metros
+b2AABB GetLevelBounds();
+
+// Crea el nivel en physics. Todo nace dormido y el pájaro sin lanzar.
+LevelBodies BuildDefaultLevel(PhysicsWrapper& physics);
+
+// Destruye los cuerpos del nivel y deja level vacío
+void DestroyLevel(PhysicsWrapper& physics, LevelBodies& level);
+
+// Quita body de level si es uno de sus cuerpos. Para
+// PhysicsWrapper::SetBodyDestroyedCallback, de modo que un cuerpo destruido
+// por otro camino (EnqueueDestroyBody) no quede colgando en la lista.
+void ForgetLevelBody(LevelBodies& level, const b2Body* body);
+
+// Lanza el pájaro con velocity (m/s) como bala; nada si ya no existe
+void LaunchBird(PhysicsWrapper& physics, const LevelBodies& level, const b2Vec2& velocity);
+
+// El cerdo ha caído por debajo de la estructura
+bool IsLevelWon(const LevelBodies& level);
+
+#endif //LEVEL_H
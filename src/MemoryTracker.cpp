@@ -0,0 +1,172 @@
+#include "MemoryTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<size_t> g_liveBytes{0};
+    std::atomic<size_t> g_peakBytes{0};
+    std::atomic<uint64_t> g_totalAllocations{0};
+    std::atomic<uint64_t> g_totalBytes{0};
+    std::atomic<size_t> g_box2dLiveBytes{0};
+
+    // Inicialización constante: se pueden usar desde operator new sin
+    // que el acceso al hilo asigne memoria
+    thread_local uint64_t t_allocations = 0;
+    thread_local uint64_t t_bytes = 0;
+
+    // Cabecera delante de cada bloque para conocer su tamaño al liberar.
+    // 16 bytes mantienen la alineación por defecto de operator new.
+    constexpr size_t kHeaderSize = 16;
+    static_assert(kHeaderSize >= sizeof(size_t), "La cabecera debe contener el tamaño");
+    static_assert(kHeaderSize % alignof(std::max_align_t) == 0, "La cabecera rompe la alineación");
+
+    void RecordAlloc(size_t size) {
+        ++t_allocations;
+        t_bytes += size;
+        g_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        g_totalBytes.fetch_add(size, std::memory_order_relaxed);
+        size_t live = g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+        size_t peak = g_peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void RecordFree(size_t size) {
+        g_liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void* TrackedMalloc(size_t size) {
+        void* raw = std::malloc(size + kHeaderSize);
+        if (!raw) {
+            return nullptr;
+        }
+        *static_cast<size_t*>(raw) = size;
+        RecordAlloc(size);
+        return static_cast<char*>(raw) + kHeaderSize;
+    }
+
+    size_t TrackedFree(void* mem) {
+        if (!mem) {
+            return 0;
+        }
+        void* raw = static_cast<char*>(mem) - kHeaderSize;
+        size_t size = *static_cast<size_t*>(raw);
+        RecordFree(size);
+        std::free(raw);
+        return size;
+    }
+
+#ifndef MEMORYTRACKER_NO_GLOBAL_NEW
+    void* TrackedNew(size_t size) {
+        if (size == 0) {
+            size = 1;
+        }
+        for (;;) {
+            void* mem = TrackedMalloc(size);
+            if (mem) {
+                return mem;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+#endif
+}
+
+namespace MemoryTracker {
+
+    MemoryStats Snapshot() {
+        MemoryStats stats;
+        stats.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = g_peakBytes.load(std::memory_order_relaxed);
+        stats.totalAllocations = g_totalAllocations.load(std::memory_order_relaxed);
+        stats.totalBytes = g_totalBytes.load(std::memory_order_relaxed);
+        stats.box2dLiveBytes = g_box2dLiveBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    ThreadAllocations ThreadSnapshot() {
+        ThreadAllocations counts;
+        counts.allocations = t_allocations;
+        counts.bytes = t_bytes;
+        return counts;
+    }
+
+    void ResetPeak() {
+        g_peakBytes.store(g_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    void* Box2DAlloc(int32_t size) {
+        void* mem = TrackedMalloc(static_cast<size_t>(size));
+        if (mem) {
+            g_box2dLiveBytes.fetch_add(static_cast<size_t>(size), std::memory_order_relaxed);
+        }
+        return mem;
+    }
+
+    void Box2DFree(void* mem) {
+        size_t size = TrackedFree(mem);
+        g_box2dLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+}
+
+// --- Reemplazo global de operator new/delete (contador para nuestro código) ---
+// La biblioteca sin ventana se compila con MEMORYTRACKER_NO_GLOBAL_NEW: una
+// .so cargada en otro proceso (Python) no debe cambiarle el operator new.
+
+#ifndef MEMORYTRACKER_NO_GLOBAL_NEW
+
+void* operator new(std::size_t size) {
+    return TrackedNew(size);
+}
+
+void* operator new[](std::size_t size) {
+    return TrackedNew(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return TrackedNew(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return TrackedNew(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* mem) noexcept {
+    TrackedFree(mem);
+}
+
+void operator delete[](void* mem) noexcept {
+    TrackedFree(mem);
+}
+
+void operator delete(void* mem, std::size_t) noexcept {
+    TrackedFree(mem);
+}
+
+void operator delete[](void* mem, std::size_t) noexcept {
+    TrackedFree(mem);
+}
+
+void operator delete(void* mem, const std::nothrow_t&) noexcept {
+    TrackedFree(mem);
+}
+
+void operator delete[](void* mem, const std::nothrow_t&) noexcept {
+    TrackedFree(mem);
+}
+
+#endif //MEMORYTRACKER_NO_GLOBAL_NEW
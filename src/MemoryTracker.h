@@ -0,0 +1,46 @@
+//
+// Contadores globales de memoria para la capa de física.
+//
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct MemoryStats {
+    size_t liveBytes = 0;          // Bytes vivos (operator new + b2Alloc)
+    size_t peakBytes = 0;          // Máximo histórico de liveBytes
+    uint64_t totalAllocations = 0; // Asignaciones desde el arranque
+    uint64_t totalBytes = 0;       // Bytes pedidos desde el arranque
+    size_t box2dLiveBytes = 0;     // Parte de liveBytes que pidió Box2D vía b2Alloc
+
+    // Medidas del último PhysicsWrapper::Update, solo del hilo que lo llamó
+    // (el hilo escritor de StateRecorder, por ejemplo, no cuenta)
+    uint64_t stepAllocations = 0;
+    uint64_t stepBytes = 0;
+};
+
+// Asignaciones hechas por un hilo desde que arrancó
+struct ThreadAllocations {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+namespace MemoryTracker {
+    // Toma una foto de los contadores globales (los campos step* quedan en cero).
+    // Con MEMORYTRACKER_NO_GLOBAL_NEW solo cuenta lo que pasa por Box2DAlloc.
+    MemoryStats Snapshot();
+
+    // Contadores del hilo que llama
+    ThreadAllocations ThreadSnapshot();
+
+    // Reinicia el pico al valor vivo actual
+    void ResetPeak();
+
+    // Hooks para Box2D. Solo se usan si Box2D se compiló con B2_USER_SETTINGS
+    // y src/b2_user_settings.h (ver Makefile, TRACK_BOX2D_ALLOC=1)
+    void* Box2DAlloc(int32_t size);
+    void Box2DFree(void* mem);
+}
+
+#endif //MEMORYTRACKER_H
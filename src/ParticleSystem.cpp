@@ -0,0 +1,548 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Límite de celdas de la rejilla de colisión; si las partículas se
+    // dispersan más, las celdas crecen en lugar de multiplicarse.
+    const size_t kMaxCollisionCells = 1 << 16;
+
+    size_t RoundUpToLanes(size_t n) {
+        return (n + 3) & ~static_cast<size_t>(3);
+    }
+
+#if defined(__SSE2__)
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128 Dot(__m128 ax, __m128 ay, __m128 bx, __m128 by) {
+        return _mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by));
+    }
+#endif
+}
+
+ParticleSystem::ParticleSystem(size_t capacity)
+    : m_capacity(capacity)
+    , m_count(0)
+    , m_randomState(0x9E3779B9u) {
+
+    // Los arrays se rellenan hasta múltiplo de 4 para que el bucle SIMD
+    // pueda leer y escribir el último grupo sin comprobar límites.
+    size_t padded = RoundUpToLanes(capacity);
+    m_posX.resize(padded, 0.0f);
+    m_posY.resize(padded, 0.0f);
+    m_velX.resize(padded, 0.0f);
+    m_velY.resize(padded, 0.0f);
+    m_life.resize(padded, 0.0f);
+
+    m_cellOf.resize(capacity);
+    m_sorted.resize(capacity);
+    m_scratch.resize(capacity);
+}
+
+void ParticleSystem::SetConfig(const ParticleConfig& config) {
+    m_config = config;
+}
+
+size_t ParticleSystem::Emit(const b2Vec2& position, const b2Vec2& direction, int32_t count, float speed, float spread) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    size_t toEmit = std::min(static_cast<size_t>(count), m_capacity - m_count);
+    float baseAngle = std::atan2(direction.y, direction.x);
+
+    for (size_t n = 0; n < toEmit; ++n) {
+        float angle = baseAngle + (NextRandom() - 0.5f) * spread;
+        float s = speed * (0.5f + 0.5f * NextRandom());
+
+        size_t i = m_count++;
+        m_posX[i] = position.x;
+        m_posY[i] = position.y;
+        m_velX[i] = s * std::cos(angle);
+        m_velY[i] = s * std::sin(angle);
+        m_life[i] = 1.0f;
+    }
+
+    return toEmit;
+}
+
+void ParticleSystem::Update(float deltaTime, b2World* world) {
+    if (m_count == 0) {
+        return;
+    }
+
+    b2Vec2 gravity = world ? world->GetGravity() : b2Vec2_zero;
+    Integrate(deltaTime, gravity);
+    RemoveDead();
+
+    if (world && m_count > 0) {
+        CollideWithWorld(world);
+    }
+}
+
+void ParticleSystem::Integrate(float deltaTime, const b2Vec2& gravity) {
+    const float damping = 1.0f / (1.0f + deltaTime * m_config.damping);
+    const float decay = m_config.lifetime > 0.0f ? deltaTime / m_config.lifetime : 1.0f;
+    const size_t n = RoundUpToLanes(m_count);
+
+    float* px = m_posX.data();
+    float* py = m_posY.data();
+    float* vx = m_velX.data();
+    float* vy = m_velY.data();
+    float* life = m_life.data();
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 dt4 = _mm_set1_ps(deltaTime);
+    const __m128 gx4 = _mm_set1_ps(gravity.x * deltaTime);
+    const __m128 gy4 = _mm_set1_ps(gravity.y * deltaTime);
+    const __m128 damp4 = _mm_set1_ps(damping);
+    const __m128 decay4 = _mm_set1_ps(decay);
+
+    for (; i < n; i += 4) {
+        __m128 vxi = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vx + i), gx4), damp4);
+        __m128 vyi = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vy + i), gy4), damp4);
+        _mm_storeu_ps(vx + i, vxi);
+        _mm_storeu_ps(vy + i, vyi);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(vxi, dt4)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(vyi, dt4)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), decay4));
+    }
+#endif
+    for (; i < n; ++i) {
+        vx[i] = (vx[i] + gravity.x * deltaTime) * damping;
+        vy[i] = (vy[i] + gravity.y * deltaTime) * damping;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        life[i] -= decay;
+    }
+}
+
+void ParticleSystem::RemoveDead() {
+    size_t i = 0;
+    while (i < m_count) {
+#if defined(__SSE2__)
+        // Grupos de cuatro vivas de una vez
+        if (i + 4 <= m_count && _mm_movemask_ps(_mm_cmpngt_ps(_mm_loadu_ps(m_life.data() + i), _mm_setzero_ps())) == 0) {
+            i += 4;
+            continue;
+        }
+#endif
+        if (m_life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+
+        size_t last = --m_count;
+        m_posX[i] = m_posX[last];
+        m_posY[i] = m_posY[last];
+        m_velX[i] = m_velX[last];
+        m_velY[i] = m_velY[last];
+        m_life[i] = m_life[last];
+    }
+}
+
+void ParticleSystem::CollideWithWorld(b2World* world) {
+    // 1. Rejilla sobre las partículas vivas
+    float minX = m_posX[0], maxX = m_posX[0];
+    float minY = m_posY[0], maxY = m_posY[0];
+    size_t i = 1;
+#if defined(__SSE2__)
+    if (m_count >= 4) {
+        __m128 minX4 = _mm_loadu_ps(m_posX.data()), maxX4 = minX4;
+        __m128 minY4 = _mm_loadu_ps(m_posY.data()), maxY4 = minY4;
+        for (i = 4; i + 4 <= m_count; i += 4) {
+            __m128 x = _mm_loadu_ps(m_posX.data() + i);
+            __m128 y = _mm_loadu_ps(m_posY.data() + i);
+            minX4 = _mm_min_ps(minX4, x);
+            maxX4 = _mm_max_ps(maxX4, x);
+            minY4 = _mm_min_ps(minY4, y);
+            maxY4 = _mm_max_ps(maxY4, y);
+        }
+        alignas(16) float lanes[4][4];
+        _mm_store_ps(lanes[0], minX4);
+        _mm_store_ps(lanes[1], maxX4);
+        _mm_store_ps(lanes[2], minY4);
+        _mm_store_ps(lanes[3], maxY4);
+        for (int k = 0; k < 4; ++k) {
+            minX = std::min(minX, lanes[0][k]);
+            maxX = std::max(maxX, lanes[1][k]);
+            minY = std::min(minY, lanes[2][k]);
+            maxY = std::max(maxY, lanes[3][k]);
+        }
+    }
+#endif
+    for (; i < m_count; ++i) {
+        minX = std::min(minX, m_posX[i]);
+        maxX = std::max(maxX, m_posX[i]);
+        minY = std::min(minY, m_posY[i]);
+        maxY = std::max(maxY, m_posY[i]);
+    }
+
+    float cellSize = std::max(m_config.collisionCellSize, 4.0f * m_config.radius);
+    size_t columns = static_cast<size_t>((maxX - minX) / cellSize) + 1;
+    size_t rows = static_cast<size_t>((maxY - minY) / cellSize) + 1;
+    if (columns * rows > kMaxCollisionCells) {
+        cellSize *= std::sqrt(static_cast<float>(columns * rows) / kMaxCollisionCells) + 1.0f;
+        columns = static_cast<size_t>((maxX - minX) / cellSize) + 1;
+        rows = static_cast<size_t>((maxY - minY) / cellSize) + 1;
+    }
+    const size_t cellCount = columns * rows;
+    const float invCell = 1.0f / cellSize;
+
+    // 2. Celda de cada partícula. Las conversiones van en float (SSE2 no
+    // tiene mínimo ni producto de enteros de 32 bits); es exacto porque
+    // hay menos de 2^24 celdas.
+    const float lastColumn = static_cast<float>(columns - 1);
+    const float lastRow = static_cast<float>(rows - 1);
+    const float stride = static_cast<float>(columns);
+    i = 0;
+#if defined(__SSE2__)
+    const __m128 minX4 = _mm_set1_ps(minX), minY4 = _mm_set1_ps(minY);
+    const __m128 invCell4 = _mm_set1_ps(invCell), stride4 = _mm_set1_ps(stride);
+    const __m128 lastColumn4 = _mm_set1_ps(lastColumn), lastRow4 = _mm_set1_ps(lastRow);
+    for (; i + 4 <= m_count; i += 4) {
+        __m128 fx = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(m_posX.data() + i), minX4), invCell4), lastColumn4);
+        __m128 fy = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(m_posY.data() + i), minY4), invCell4), lastRow4);
+        __m128 cx = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+        __m128 cy = _mm_cvtepi32_ps(_mm_cvttps_epi32(fy));
+        __m128i cell = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(cy, stride4), cx));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(m_cellOf.data() + i), cell);
+    }
+#endif
+    for (; i < m_count; ++i) {
+        float cx = std::floor(std::min((m_posX[i] - minX) * invCell, lastColumn));
+        float cy = std::floor(std::min((m_posY[i] - minY) * invCell, lastRow));
+        m_cellOf[i] = static_cast<uint32_t>(cy * stride + cx);
+    }
+
+    // 3. Ordenar por celda (counting sort). Como los fotogramas son
+    // coherentes, lo normal es que ya estén ordenadas (siempre, con todo en
+    // reposo): entonces basta con anotar dónde acaba cada celda.
+    m_cellStart.assign(cellCount, 0);
+    bool ordered = true;
+    for (size_t k = 0; k + 1 < m_count && ordered; ++k) {
+        if (m_cellOf[k + 1] != m_cellOf[k]) {
+            ordered = m_cellOf[k + 1] > m_cellOf[k];
+            m_cellStart[m_cellOf[k]] = static_cast<uint32_t>(k + 1);
+        }
+    }
+
+    if (ordered) {
+        m_cellStart[m_cellOf[m_count - 1]] = static_cast<uint32_t>(m_count);
+        for (size_t c = 1; c < cellCount; ++c) {
+            m_cellStart[c] = std::max(m_cellStart[c], m_cellStart[c - 1]);
+        }
+    } else {
+        std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+        for (size_t k = 0; k < m_count; ++k) {
+            ++m_cellStart[m_cellOf[k]];
+        }
+
+        uint32_t offset = 0;
+        for (size_t c = 0; c < cellCount; ++c) {
+            uint32_t count = m_cellStart[c];
+            m_cellStart[c] = offset;
+            offset += count;
+        }
+        for (size_t k = 0; k < m_count; ++k) {
+            m_sorted[m_cellStart[m_cellOf[k]]++] = static_cast<uint32_t>(k);
+        }
+
+        // Reordenar los arrays por celda: las pruebas de abajo leen secuencialmente
+        Permute(m_posX);
+        Permute(m_posY);
+        Permute(m_velX);
+        Permute(m_velY);
+        Permute(m_life);
+    }
+    // Ahora m_cellStart[c] es el final de la celda c (y el inicio de c + 1)
+
+    // 4. Una consulta al broadphase por celda ocupada
+    m_queryCallback.fixtures = &m_cellFixtures;
+    const float r = m_config.radius;
+
+    for (size_t c = 0; c < cellCount; ++c) {
+        uint32_t begin = c > 0 ? m_cellStart[c - 1] : 0;
+        uint32_t end = m_cellStart[c];
+        if (begin == end) {
+            continue;
+        }
+
+        float cellX = minX + static_cast<float>(c % columns) * cellSize;
+        float cellY = minY + static_cast<float>(c / columns) * cellSize;
+
+        // Margen de 2r: cubre el radio y el redondeo de la última fila/columna
+        b2AABB query;
+        query.lowerBound.Set(cellX - 2.0f * r, cellY - 2.0f * r);
+        query.upperBound.Set(cellX + cellSize + 2.0f * r, cellY + cellSize + 2.0f * r);
+
+        m_cellFixtures.clear();
+        world->QueryAABB(&m_queryCallback, query);
+        if (m_cellFixtures.empty()) {
+            continue;
+        }
+
+        BuildWorldShapes();
+        CollideCell(begin, end);
+    }
+}
+
+void ParticleSystem::Permute(std::vector<float>& values) {
+    for (size_t k = 0; k < m_count; ++k) {
+        m_scratch[k] = values[m_sorted[k]];
+    }
+    std::copy(m_scratch.begin(), m_scratch.begin() + m_count, values.begin());
+}
+
+void ParticleSystem::BuildWorldShapes() {
+    if (m_shapes.size() < m_cellFixtures.size()) {
+        m_shapes.resize(m_cellFixtures.size());
+    }
+
+    for (size_t j = 0; j < m_cellFixtures.size(); ++j) {
+        b2Fixture* fixture = m_cellFixtures[j];
+        const b2Transform& xf = fixture->GetBody()->GetTransform();
+        WorldShape& shape = m_shapes[j];
+
+        if (fixture->GetType() == b2Shape::e_circle) {
+            const b2CircleShape* circle = static_cast<const b2CircleShape*>(fixture->GetShape());
+            shape.isCircle = true;
+            shape.circle.center = b2Mul(xf, circle->m_p);
+            shape.circle.radius = circle->m_radius;
+        } else if (fixture->GetType() == b2Shape::e_polygon) {
+            const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(fixture->GetShape());
+            shape.isCircle = false;
+            shape.count = poly->m_count;
+            for (int32 i = 0; i < poly->m_count; ++i) {
+                shape.vertices[i] = b2Mul(xf, poly->m_vertices[i]);
+                shape.normals[i] = b2Mul(xf.q, poly->m_normals[i]);
+            }
+        } else {
+            // Edge/chain: Collision no los soporta
+            shape.isCircle = false;
+            shape.count = 0;
+        }
+    }
+}
+
+void ParticleSystem::CollideCell(uint32_t begin, uint32_t end) {
+    const float r = m_config.radius;
+
+    for (size_t j = 0; j < m_cellFixtures.size(); ++j) {
+        const WorldShape& shape = m_shapes[j];
+
+        if (shape.isCircle) {
+            for (uint32_t i = begin; i < end; ++i) {
+                Circle particle = { b2Vec2(m_posX[i], m_posY[i]), r };
+                // Normal orientada desde la forma hacia la partícula
+                ResolveContact(i, Collision::CheckCircleToCircle(shape.circle, particle));
+            }
+        } else if (shape.count > 0) {
+            CollidePolygon(begin, end, shape);
+        }
+    }
+}
+
+void ParticleSystem::CollidePolygon(uint32_t begin, uint32_t end, const WorldShape& shape) {
+    const float r = m_config.radius;
+    const int32 count = shape.count;
+    uint32_t i = begin;
+
+#if defined(__SSE2__)
+    // CheckParticleToPolygon de cuatro en cuatro, y el contacto se resuelve en
+    // los mismos registros: nada de ContactInfo intermedios por partícula
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 r4 = _mm_set1_ps(r);
+    const __m128 rSq4 = _mm_set1_ps(r * r);
+    const __m128 epsilon = _mm_set1_ps(std::numeric_limits<float>::epsilon());
+    const __m128 tinySq = _mm_set1_ps(1e-8f);
+    const __m128 keep = _mm_set1_ps(1.0f - m_config.friction);
+    const __m128 bounce = _mm_set1_ps(m_config.restitution);
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(m_posX.data() + i);
+        __m128 y = _mm_loadu_ps(m_posY.data() + i);
+
+        // Cara de máxima separación; solo se sigue su índice y después se
+        // recogen normal y extremos de la arista carril a carril
+        __m128 separation = _mm_set1_ps(-std::numeric_limits<float>::max());
+        __m128 face = zero;
+        for (int32 e = 0; e < count; ++e) {
+            __m128 rx = _mm_sub_ps(x, _mm_set1_ps(shape.vertices[e].x));
+            __m128 ry = _mm_sub_ps(y, _mm_set1_ps(shape.vertices[e].y));
+            __m128 s = Dot(_mm_set1_ps(shape.normals[e].x), _mm_set1_ps(shape.normals[e].y), rx, ry);
+            __m128 better = _mm_cmpgt_ps(s, separation);
+            separation = _mm_max_ps(s, separation);
+            face = Select(better, _mm_set1_ps(static_cast<float>(e)), face);
+        }
+
+        __m128 hit = _mm_cmple_ps(separation, r4);
+        if (_mm_movemask_ps(hit) == 0) {
+            continue;
+        }
+
+        // Lo habitual (todo apoyado en la misma cara) es que coincidan los
+        // cuatro carriles
+        alignas(16) float faces[4];
+        _mm_store_ps(faces, face);
+        __m128 nx, ny, v1x, v1y, v2x, v2y;
+        if (_mm_movemask_ps(_mm_cmpeq_ps(face, _mm_set1_ps(faces[0]))) == 0xF) {
+            int32 e = static_cast<int32>(faces[0]);
+            const b2Vec2& a = shape.vertices[e];
+            const b2Vec2& b = shape.vertices[e + 1 < count ? e + 1 : 0];
+            nx = _mm_set1_ps(shape.normals[e].x);
+            ny = _mm_set1_ps(shape.normals[e].y);
+            v1x = _mm_set1_ps(a.x);
+            v1y = _mm_set1_ps(a.y);
+            v2x = _mm_set1_ps(b.x);
+            v2y = _mm_set1_ps(b.y);
+        } else {
+            int32 e[4], f[4];
+            for (int k = 0; k < 4; ++k) {
+                e[k] = static_cast<int32>(faces[k]);
+                f[k] = e[k] + 1 < count ? e[k] + 1 : 0;
+            }
+            const b2Vec2* n = shape.normals;
+            const b2Vec2* v = shape.vertices;
+            nx = _mm_setr_ps(n[e[0]].x, n[e[1]].x, n[e[2]].x, n[e[3]].x);
+            ny = _mm_setr_ps(n[e[0]].y, n[e[1]].y, n[e[2]].y, n[e[3]].y);
+            v1x = _mm_setr_ps(v[e[0]].x, v[e[1]].x, v[e[2]].x, v[e[3]].x);
+            v1y = _mm_setr_ps(v[e[0]].y, v[e[1]].y, v[e[2]].y, v[e[3]].y);
+            v2x = _mm_setr_ps(v[f[0]].x, v[f[1]].x, v[f[2]].x, v[f[3]].x);
+            v2y = _mm_setr_ps(v[f[0]].y, v[f[1]].y, v[f[2]].y, v[f[3]].y);
+        }
+
+        // Fuera del polígono y más allá de un extremo de la arista: el
+        // contacto es con ese vértice
+        __m128 ex = _mm_sub_ps(v2x, v1x), ey = _mm_sub_ps(v2y, v1y);
+        __m128 outside = _mm_cmpge_ps(separation, epsilon);
+        __m128 u1 = Dot(_mm_sub_ps(x, v1x), _mm_sub_ps(y, v1y), ex, ey);
+        __m128 u2 = Dot(_mm_sub_ps(v2x, x), _mm_sub_ps(v2y, y), ex, ey);
+        __m128 atV1 = _mm_and_ps(outside, _mm_cmple_ps(u1, zero));
+        __m128 atVertex = _mm_or_ps(atV1, _mm_and_ps(outside, _mm_cmple_ps(u2, zero)));
+
+        __m128 depth = _mm_sub_ps(r4, separation);
+        if (_mm_movemask_ps(atVertex) != 0) {
+            __m128 dx = _mm_sub_ps(x, Select(atV1, v1x, v2x));
+            __m128 dy = _mm_sub_ps(y, Select(atV1, v1y, v2y));
+            __m128 distSq = Dot(dx, dy, dx, dy);
+            __m128 dist = _mm_sqrt_ps(distSq);
+            __m128 nonDegenerate = _mm_cmpgt_ps(dist, zero);
+            __m128 invDist = _mm_div_ps(one, Select(nonDegenerate, dist, one));
+
+            hit = _mm_andnot_ps(_mm_and_ps(atVertex, _mm_cmpgt_ps(distSq, rSq4)), hit);
+            __m128 vertexNormal = _mm_and_ps(atVertex, nonDegenerate);
+            nx = Select(vertexNormal, _mm_mul_ps(dx, invDist), nx);
+            ny = Select(vertexNormal, _mm_mul_ps(dy, invDist), ny);
+            depth = Select(atVertex, _mm_sub_ps(r4, dist), depth);
+        }
+        depth = _mm_and_ps(hit, depth);
+
+        _mm_storeu_ps(m_posX.data() + i, _mm_add_ps(x, _mm_mul_ps(depth, nx)));
+        _mm_storeu_ps(m_posY.data() + i, _mm_add_ps(y, _mm_mul_ps(depth, ny)));
+
+        // Misma respuesta que ResolveContact
+        __m128 vx = _mm_loadu_ps(m_velX.data() + i);
+        __m128 vy = _mm_loadu_ps(m_velY.data() + i);
+        __m128 vn = Dot(vx, vy, nx, ny);
+        __m128 approaching = _mm_and_ps(hit, _mm_cmplt_ps(vn, zero));
+        __m128 tx = _mm_sub_ps(vx, _mm_mul_ps(vn, nx));
+        __m128 ty = _mm_sub_ps(vy, _mm_mul_ps(vn, ny));
+        __m128 moving = _mm_cmpge_ps(Dot(tx, ty, tx, ty), tinySq);
+        tx = _mm_and_ps(moving, tx);
+        ty = _mm_and_ps(moving, ty);
+        __m128 reflected = _mm_mul_ps(bounce, vn);
+        __m128 newVx = _mm_sub_ps(_mm_mul_ps(keep, tx), _mm_mul_ps(reflected, nx));
+        __m128 newVy = _mm_sub_ps(_mm_mul_ps(keep, ty), _mm_mul_ps(reflected, ny));
+        _mm_storeu_ps(m_velX.data() + i, Select(approaching, newVx, vx));
+        _mm_storeu_ps(m_velY.data() + i, Select(approaching, newVy, vy));
+    }
+#endif
+    for (; i < end; ++i) {
+        ResolveContact(i, CheckParticleToPolygon(b2Vec2(m_posX[i], m_posY[i]), r, shape));
+    }
+}
+
+ContactInfo ParticleSystem::CheckParticleToPolygon(const b2Vec2& center, float radius, const WorldShape& shape) {
+    ContactInfo result;
+
+    // Cara de máxima separación; si alguna supera el radio no hay contacto
+    int32 normalIndex = 0;
+    float separation = -std::numeric_limits<float>::max();
+    for (int32 i = 0; i < shape.count; ++i) {
+        float s = b2Dot(shape.normals[i], center - shape.vertices[i]);
+        if (s > radius) {
+            return result;
+        }
+        if (s > separation) {
+            separation = s;
+            normalIndex = i;
+        }
+    }
+
+    const b2Vec2& v1 = shape.vertices[normalIndex];
+    const b2Vec2& v2 = shape.vertices[normalIndex + 1 < shape.count ? normalIndex + 1 : 0];
+    result.hasCollision = true;
+    result.normal = shape.normals[normalIndex];
+    result.depth = radius - separation;
+
+    // Fuera del polígono, junto a un vértice de la cara
+    if (separation >= std::numeric_limits<float>::epsilon()) {
+        float u1 = b2Dot(center - v1, v2 - v1);
+        float u2 = b2Dot(v2 - center, v2 - v1);
+        if (u1 <= 0.0f || u2 <= 0.0f) {
+            b2Vec2 d = center - (u1 <= 0.0f ? v1 : v2);
+            float distSq = d.LengthSquared();
+            if (distSq > radius * radius) {
+                result.hasCollision = false;
+                return result;
+            }
+            float dist = std::sqrt(distSq);
+            if (dist > 0.0f) {
+                result.normal = (1.0f / dist) * d;
+            }
+            result.depth = radius - dist;
+        }
+    }
+    return result;
+}
+
+void ParticleSystem::ResolveContact(size_t i, const ContactInfo& info) {
+    if (!info.hasCollision) {
+        return;
+    }
+
+    m_posX[i] += info.depth * info.normal.x;
+    m_posY[i] += info.depth * info.normal.y;
+
+    b2Vec2 v(m_velX[i], m_velY[i]);
+    float vn = b2Dot(v, info.normal);
+    if (vn < 0.0f) {
+        b2Vec2 tangent = v - vn * info.normal;
+        // La fricción reduce la tangente geométricamente; cortarla antes de
+        // que llegue a valores desnormalizados, que disparan el coste del SIMD
+        if (tangent.LengthSquared() < 1e-8f) {
+            tangent.SetZero();
+        }
+        v = (1.0f - m_config.friction) * tangent - m_config.restitution * vn * info.normal;
+        m_velX[i] = v.x;
+        m_velY[i] = v.y;
+    }
+}
+
+float ParticleSystem::NextRandom() {
+    // xorshift32: suficiente para dispersión cosmética
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 17;
+    m_randomState ^= m_randomState << 5;
+    return static_cast<float>(m_randomState >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,113 @@
+//
+// Partículas cosméticas (escombros, polvo) sin cuerpos de Box2D.
+//
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <box2d/box2d.h>
+#include "Collision.h"
+#include <cstdint>
+#include <vector>
+
+struct ParticleConfig {
+    float radius = 0.05f;            // Radio de colisión (metros)
+    float lifetime = 2.0f;           // Segundos de vida
+    float damping = 0.1f;            // Arrastre lineal
+    float restitution = 0.3f;
+    float friction = 0.4f;
+    float collisionCellSize = 2.0f;  // Celda para agrupar consultas al broadphase
+
+    // Emisión desde PostSolve
+    bool spawnOnImpact = true;
+    float spawnImpulseThreshold = 10.0f;
+    float particlesPerImpulse = 2.0f;
+    int32_t maxParticlesPerImpact = 64;
+    float spawnSpeed = 3.0f;
+};
+
+// Sistema de partículas en SoA (un array por componente). La integración se
+// hace de cuatro en cuatro con SSE2 cuando está disponible, y la colisión con
+// el mundo se agrupa por celdas: una sola QueryAABB por celda ocupada, y luego
+// las partículas de la celda se prueban y resuelven de cuatro en cuatro contra
+// cada polígono devuelto (regiones de cara y de vértice, como Box2D).
+// Las partículas no empujan a los cuerpos.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(size_t capacity = 50000);
+
+    void SetConfig(const ParticleConfig& config);
+    const ParticleConfig& GetConfig() const { return m_config; }
+
+    // Emite hasta count partículas en un abanico de ángulo spread alrededor de
+    // direction. Devuelve cuántas cupieron.
+    size_t Emit(const b2Vec2& position, const b2Vec2& direction, int32_t count, float speed, float spread);
+
+    void Update(float deltaTime, b2World* world);
+    void Clear() { m_count = 0; }
+
+    size_t GetCount() const { return m_count; }
+    size_t GetCapacity() const { return m_capacity; }
+    float GetRadius() const { return m_config.radius; }
+    const float* GetPositionsX() const { return m_posX.data(); }
+    const float* GetPositionsY() const { return m_posY.data(); }
+    const float* GetLife() const { return m_life.data(); } // Fracción de vida restante [0, 1]
+
+private:
+    struct WorldShape {
+        bool isCircle;
+        Circle circle;
+        int32 count;
+        b2Vec2 vertices[b2_maxPolygonVertices];
+        b2Vec2 normals[b2_maxPolygonVertices];
+    };
+
+    class CellQueryCallback : public b2QueryCallback {
+    public:
+        std::vector<b2Fixture*>* fixtures = nullptr;
+
+        bool ReportFixture(b2Fixture* fixture) override {
+            if (!fixture->IsSensor()) {
+                fixtures->push_back(fixture);
+            }
+            return true;
+        }
+    };
+
+    void Integrate(float deltaTime, const b2Vec2& gravity);
+    void RemoveDead();
+    void CollideWithWorld(b2World* world);
+    void Permute(std::vector<float>& values);
+    void BuildWorldShapes();
+    void CollideCell(uint32_t begin, uint32_t end);
+    void CollidePolygon(uint32_t begin, uint32_t end, const WorldShape& shape);
+    // No es Collision::CheckCircleToPolygon: aquel toma la profundidad del SAT
+    // (intersección de proyecciones), y una partícula que se hunde más que su
+    // diámetro en un polígono largo sale por el costado y lo atraviesa. Aquí
+    // se usa la separación a la cara, que siempre la empuja hacia fuera.
+    static ContactInfo CheckParticleToPolygon(const b2Vec2& center, float radius, const WorldShape& shape);
+    void ResolveContact(size_t i, const ContactInfo& info);
+    float NextRandom();
+
+    ParticleConfig m_config;
+    size_t m_capacity;
+    size_t m_count;
+
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_life;
+
+    // Buffers reutilizados entre pasos para no asignar memoria en Update
+    std::vector<uint32_t> m_cellOf;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_sorted;
+    std::vector<float> m_scratch;
+    std::vector<b2Fixture*> m_cellFixtures;
+    std::vector<WorldShape> m_shapes;
+    CellQueryCallback m_queryCallback;
+
+    uint32_t m_randomState;
+};
+
+#endif //PARTICLESYSTEM_H
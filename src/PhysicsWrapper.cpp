@@ -1,11 +1,307 @@
 #include "PhysicsWrapper.h"
 #include "Collision.h"
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
+
+namespace {
+    // b2PolygonShape::Set no devuelve nada: con una envolvente degenerada
+    // salta un assert (o queda una caja de 1x1 en release). Se repiten antes
+    // sus comprobaciones (Box2D 2.4.1): soldado de vértices, envolvente
+    // convexa por gift wrapping, aristas y área mínimas.
+    bool SetPolygonChecked(b2PolygonShape& shape, const b2Vec2* vertices, int32 count) {
+        if (count < 3 || count > b2_maxPolygonVertices) {
+            return false;
+        }
+
+        const float weldDistance = 0.5f * b2_linearSlop;
+        b2Vec2 points[b2_maxPolygonVertices];
+        int32 n = 0;
+        for (int32 i = 0; i < count; ++i) {
+            bool unique = true;
+            for (int32 j = 0; j < n; ++j) {
+                if (b2DistanceSquared(vertices[i], points[j]) < weldDistance * weldDistance) {
+                    unique = false;
+                    break;
+                }
+            }
+            if (unique) {
+                points[n++] = vertices[i];
+            }
+        }
+        if (n < 3) {
+            return false;
+        }
+
+        // Desde el punto más a la derecha (el más bajo si empatan)
+        int32 i0 = 0;
+        for (int32 i = 1; i < n; ++i) {
+            if (points[i].x > points[i0].x || (points[i].x == points[i0].x && points[i].y < points[i0].y)) {
+                i0 = i;
+            }
+        }
+
+        int32 hull[b2_maxPolygonVertices];
+        int32 m = 0;
+        int32 ih = i0;
+        for (;;) {
+            if (m == n) {
+                return false; // No cierra: puntos casi alineados
+            }
+            hull[m] = ih;
+
+            int32 ie = 0;
+            for (int32 j = 1; j < n; ++j) {
+                if (ie == ih) {
+                    ie = j;
+                    continue;
+                }
+                b2Vec2 r = points[ie] - points[hull[m]];
+                b2Vec2 v = points[j] - points[hull[m]];
+                float c = b2Cross(r, v);
+                if (c < 0.0f || (c == 0.0f && v.LengthSquared() > r.LengthSquared())) {
+                    ie = j;
+                }
+            }
+
+            ++m;
+            ih = ie;
+            if (ie == i0) {
+                break;
+            }
+        }
+        if (m < 3) {
+            return false;
+        }
+
+        float area = 0.0f;
+        const b2Vec2& s = points[hull[0]];
+        for (int32 i = 0; i < m; ++i) {
+            const b2Vec2& p1 = points[hull[i]];
+            const b2Vec2& p2 = points[hull[i + 1 < m ? i + 1 : 0]];
+            if ((p2 - p1).LengthSquared() <= b2_epsilon * b2_epsilon) {
+                return false;
+            }
+            area += 0.5f * b2Cross(p1 - s, p2 - s);
+        }
+        if (area <= b2_epsilon) {
+            return false;
+        }
+
+        shape.Set(vertices, count);
+        return true;
+    }
+
+    b2Sweep MakeSweep(b2Body* body, float deltaTime) {
+        b2Sweep sweep;
+        sweep.localCenter = body->GetLocalCenter();
+        sweep.c0 = body->GetWorldCenter();
+        sweep.a0 = body->GetAngle();
+        sweep.c = sweep.c0;
+        sweep.a = sweep.a0;
+        sweep.alpha0 = 0.0f;
+        if (body->GetType() != b2_staticBody && body->IsAwake()) {
+            sweep.c += deltaTime * body->GetLinearVelocity();
+            sweep.a += deltaTime * body->GetAngularVelocity();
+        }
+        return sweep;
+    }
+
+    bool ShouldCollide(const b2Fixture* a, const b2Fixture* b) {
+        const b2Filter& fa = a->GetFilterData();
+        const b2Filter& fb = b->GetFilterData();
+        if (fa.groupIndex == fb.groupIndex && fa.groupIndex != 0) {
+            return fa.groupIndex > 0;
+        }
+        return (fa.maskBits & fb.categoryBits) != 0 && (fa.categoryBits & fb.maskBits) != 0;
+    }
+
+    // --- Tabla de kernels de colisión por tipo de forma y número de vértices ---
+
+    enum ShapeSlot {
+        e_slotCircle,
+        e_slotTriangle,
+        e_slotBox,      // 4 vértices con aristas opuestas paralelas (SetAsBox)
+        e_slotQuad,
+        e_slotHexagon,
+        e_slotPolygon,  // Resto de polígonos: camino genérico con Polygon
+        e_slotOther,    // Edge/chain: se deja a Box2D
+        e_slotCount
+    };
+
+    ShapeSlot GetShapeSlot(const b2Shape* shape) {
+        if (shape->GetType() == b2Shape::e_circle) {
+            return e_slotCircle;
+        }
+        if (shape->GetType() != b2Shape::e_polygon) {
+            return e_slotOther;
+        }
+
+        const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(shape);
+        switch (poly->m_count) {
+            case 3:
+                return e_slotTriangle;
+            case 4: {
+                const float parallel = -1.0f + 1e-5f;
+                bool isBox = b2Dot(poly->m_normals[0], poly->m_normals[2]) < parallel &&
+                             b2Dot(poly->m_normals[1], poly->m_normals[3]) < parallel;
+                return isBox ? e_slotBox : e_slotQuad;
+            }
+            case 6:
+                return e_slotHexagon;
+            default:
+                return e_slotPolygon;
+        }
+    }
+
+    struct CircleKind {
+        using Type = Circle;
+        static void Load(const b2Shape* shape, const b2Transform& xf, Circle& out) {
+            const b2CircleShape* circle = static_cast<const b2CircleShape*>(shape);
+            out.center = b2Mul(xf, circle->m_p);
+            out.radius = circle->m_radius;
+        }
+    };
+
+    template <int N, int Axes = N>
+    struct FixedKind {
+        using Type = FixedPolygon<N, Axes>;
+        static void Load(const b2Shape* shape, const b2Transform& xf, Type& out) {
+            const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(shape);
+            for (int i = 0; i < N; ++i) {
+                out.vertices[i] = b2Mul(xf, poly->m_vertices[i]);
+            }
+            // Las normales de Box2D ya son unitarias; en una caja las dos
+            // primeras son las únicas (las otras dos son sus opuestas)
+            for (int i = 0; i < Axes; ++i) {
+                out.normals[i] = b2Mul(xf.q, poly->m_normals[i]);
+            }
+        }
+    };
+
+    struct GenericKind {
+        using Type = Polygon;
+        static void Load(const b2Shape* shape, const b2Transform& xf, Polygon& out) {
+            const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(shape);
+            out.vertices.clear();
+            for (int i = 0; i < poly->m_count; ++i) {
+                out.vertices.push_back(b2Mul(xf, poly->m_vertices[i]));
+            }
+            out.ComputeNormals();
+        }
+    };
+
+    using TriangleKind = FixedKind<3>;
+    using BoxKind = FixedKind<4, 2>;
+    using QuadKind = FixedKind<4>;
+    using HexagonKind = FixedKind<6>;
+
+    // Mismas convenciones de normal que la cadena if/else original: en
+    // polígono-círculo se invierte la normal de CheckCircleToPolygon.
+    ContactInfo Check(const Circle& a, const Circle& b) {
+        return Collision::CheckCircleToCircle(a, b);
+    }
+
+    template <class PolygonType>
+    ContactInfo Check(const Circle& a, const PolygonType& b) {
+        return Collision::CheckCircleToPolygon(a, b);
+    }
+
+    template <class PolygonType>
+    ContactInfo Check(const PolygonType& a, const Circle& b) {
+        ContactInfo result = Collision::CheckCircleToPolygon(b, a);
+        if (result.hasCollision) {
+            result.normal = -result.normal;
+        }
+        return result;
+    }
+
+    template <class PolygonA, class PolygonB>
+    ContactInfo Check(const PolygonA& a, const PolygonB& b) {
+        return Collision::CheckPolygonToPolygon(a, b);
+    }
+
+    // Si un lado cae en el camino genérico, el otro polígono también
+    template <class Kind, class Other>
+    using ResolveKind = typename std::conditional<
+        std::is_same<Other, GenericKind>::value && !std::is_same<Kind, CircleKind>::value,
+        GenericKind, Kind>::type;
+
+    // Formas de trabajo reutilizadas entre llamadas, para que el camino
+    // genérico no asigne sus vectores en cada contacto
+    template <class Kind, int Side>
+    typename Kind::Type& ScratchShape() {
+        static thread_local typename Kind::Type shape;
+        return shape;
+    }
+
+    template <class KindA, class KindB>
+    ContactInfo RunKernel(const b2Shape* shapeA, const b2Transform& xfA, const b2Shape* shapeB, const b2Transform& xfB) {
+        using A = ResolveKind<KindA, KindB>;
+        using B = ResolveKind<KindB, KindA>;
+        typename A::Type& a = ScratchShape<A, 0>();
+        typename B::Type& b = ScratchShape<B, 1>();
+        A::Load(shapeA, xfA, a);
+        B::Load(shapeB, xfB, b);
+        return Check(a, b);
+    }
+
+    ContactInfo UnsupportedKernel(const b2Shape*, const b2Transform&, const b2Shape*, const b2Transform&) {
+        // Para otros tipos de formas (edge, chain), usar detección de Box2D
+        ContactInfo result;
+        result.hasCollision = true;
+        return result;
+    }
+
+    using CollisionKernel = ContactInfo (*)(const b2Shape*, const b2Transform&, const b2Shape*, const b2Transform&);
+
+#define COLLISION_KERNEL_ROW(KindA) {                                                  \
+        &RunKernel<KindA, CircleKind>, &RunKernel<KindA, TriangleKind>,                \
+        &RunKernel<KindA, BoxKind>, &RunKernel<KindA, QuadKind>,                       \
+        &RunKernel<KindA, HexagonKind>, &RunKernel<KindA, GenericKind>,                \
+        &UnsupportedKernel }
+
+    const CollisionKernel kCollisionKernels[e_slotCount][e_slotCount] = {
+        COLLISION_KERNEL_ROW(CircleKind),
+        COLLISION_KERNEL_ROW(TriangleKind),
+        COLLISION_KERNEL_ROW(BoxKind),
+        COLLISION_KERNEL_ROW(QuadKind),
+        COLLISION_KERNEL_ROW(HexagonKind),
+        COLLISION_KERNEL_ROW(GenericKind),
+        { &UnsupportedKernel, &UnsupportedKernel, &UnsupportedKernel, &UnsupportedKernel,
+          &UnsupportedKernel, &UnsupportedKernel, &UnsupportedKernel }
+    };
+
+#undef COLLISION_KERNEL_ROW
+
+    // Forma del fixture en coordenadas locales del cuerpo
+    bool GetLocalShape(const b2Fixture* fixture, Circle& circle, Polygon& polygon, bool& isCircle) {
+        if (fixture->GetType() == b2Shape::e_circle) {
+            const b2CircleShape* shape = static_cast<const b2CircleShape*>(fixture->GetShape());
+            circle = { shape->m_p, shape->m_radius };
+            isCircle = true;
+            return true;
+        }
+        if (fixture->GetType() == b2Shape::e_polygon) {
+            const b2PolygonShape* shape = static_cast<const b2PolygonShape*>(fixture->GetShape());
+            polygon.vertices.assign(shape->m_vertices, shape->m_vertices + shape->m_count);
+            isCircle = false;
+            return true;
+        }
+        return false;
+    }
+}
 
 PhysicsWrapper::PhysicsWrapper(const b2Vec2& gravity)
     : m_useCustomDetection(true)
+    , m_logContacts(true)
+    , m_debugDraw(nullptr)
+    , m_circleBatchThreshold(8)
+    , m_trajectoryTolerance(0.25f)
     , m_velocityIterations(6)
-    , m_positionIterations(2) {
+    , m_positionIterations(2)
+    , m_commandsApplied(0)
+    , m_commandsOrphaned(0) {
 
     m_world = std::make_unique<b2World>(gravity);
     m_world->SetContactListener(this);
@@ -18,11 +314,80 @@ PhysicsWrapper::PhysicsWrapper(const b2Vec2& gravity)
 PhysicsWrapper::~PhysicsWrapper() {
 }
 
+void PhysicsWrapper::ResetWorld() {
+    // Las regiones tienen punteros a los cuerpos y hay que soltarlas antes
+    DisableRegions();
+
+    b2Body* body = m_world->GetBodyList();
+    while (body) {
+        b2Body* next = body->GetNext();
+        DestroyBody(body);
+        body = next;
+    }
+
+    const b2Vec2 gravity = m_world->GetGravity();
+    const bool allowSleeping = m_world->GetAllowSleeping();
+    const bool warmStarting = m_world->GetWarmStarting();
+    const bool continuousPhysics = m_world->GetContinuousPhysics();
+    const bool subStepping = m_world->GetSubStepping();
+
+    m_world = std::make_unique<b2World>(gravity);
+    m_world->SetContactListener(this);
+    m_world->SetDebugDraw(m_debugDraw);
+    m_world->SetAllowSleeping(allowSleeping);
+    m_world->SetWarmStarting(warmStarting);
+    m_world->SetContinuousPhysics(continuousPhysics);
+    m_world->SetSubStepping(subStepping);
+
+    m_contactCache.Clear();
+    m_bulletHits.clear();
+    m_particles.Clear();
+    m_forceFields.Clear();
+    InvalidateTrajectory();
+}
+
 void PhysicsWrapper::Update(float deltaTime) {
-    m_contactCache.clear();
+    ThreadAllocations before = MemoryTracker::ThreadSnapshot();
+
+    // Sitio para todos los contactos actuales: en régimen estable la caché
+    // ya no crece y rellenarla no asigna memoria
+    m_contactCache.Clear();
+    m_contactCache.Reserve(static_cast<size_t>(m_world->GetContactCount()));
+
+    // Punto fijo de aplicación de las mutaciones de otros hilos
+    ApplyCommands();
+
+    if (m_regions) {
+        m_regions->Update(deltaTime);
+
+        // Un impulso de un solo paso debe alcanzar también lo congelado;
+        // los campos persistentes actúan sobre lo que ya está activo
+        for (size_t i = 0; i < m_forceFields.GetCount(); ++i) {
+            const ForceField& field = m_forceFields.GetField(i);
+            if (field.impulse) {
+                m_regions->ThawRegionsOverlapping(field.GetBounds());
+            }
+        }
+    }
+
+    m_forceFields.Apply(m_world.get(), deltaTime);
+
+    if (m_useCustomDetection) {
+        SweepBullets(deltaTime);
+        PrecomputeCircleContacts();
+    }
 
     m_world->Step(deltaTime, m_velocityIterations, m_positionIterations);
 
+    m_particles.Update(deltaTime, m_world.get());
+
+    m_recorder.Capture(deltaTime);
+
+    ThreadAllocations after = MemoryTracker::ThreadSnapshot();
+    m_memoryStats = MemoryTracker::Snapshot();
+    m_memoryStats.stepAllocations = after.allocations - before.allocations;
+    m_memoryStats.stepBytes = after.bytes - before.bytes;
+
     // Opcional: limpiar cuerpos marcados para destrucción
     // (si implementas un sistema de destrucción diferida)
 }
@@ -32,7 +397,7 @@ void PhysicsWrapper::BeginContact(b2Contact* contact) {
     b2Fixture* fixtureB = contact->GetFixtureB();
 
     // Log para debugging
-    if (m_useCustomDetection) {
+    if (m_useCustomDetection && m_logContacts) {
         std::cout << "[BeginContact] Contacto iniciado entre fixtures" << std::endl;
     }
 
@@ -47,7 +412,7 @@ void PhysicsWrapper::EndContact(b2Contact* contact) {
     b2Fixture* fixtureB = contact->GetFixtureB();
 
     // Log para debugging
-    if (m_useCustomDetection) {
+    if (m_useCustomDetection && m_logContacts) {
         std::cout << "[EndContact] Contacto terminado entre fixtures" << std::endl;
     }
 
@@ -57,7 +422,7 @@ void PhysicsWrapper::EndContact(b2Contact* contact) {
     }
 
     // Limpiar del cache si existe
-    m_contactCache.erase(contact);
+    m_contactCache.Erase(contact);
 }
 
 void PhysicsWrapper::PreSolve(b2Contact* contact, const b2Manifold* oldManifold) {
@@ -74,23 +439,35 @@ void PhysicsWrapper::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
     const b2Transform& xfB = bodyB->GetTransform();
 
     ContactInfo result;
-    auto cacheIt = m_contactCache.find(contact);
-    if (cacheIt != m_contactCache.end()) {
-        result = cacheIt->second;
+    const ContactInfo* cached = m_contactCache.Find(contact);
+    if (cached) {
+        result = *cached;
     } else {
         result = PerformCustomCollisionCheck(fixtureA, fixtureB, xfA, xfB);
-        m_contactCache[contact] = result;
+        m_contactCache.Insert(contact, result);
+    }
+
+    // Una bala detenida en su tiempo de impacto queda b2_linearSlop antes del
+    // contacto y el SAT no ve solape. El lote de círculos se calcula después
+    // de SweepBullets, con la bala ya detenida, así que la caché también
+    // puede traer ese "sin colisión": hay que mirarlo en los dos caminos.
+    if (!result.hasCollision && FindBulletHit(fixtureA, fixtureB, result)) {
+        m_contactCache.Insert(contact, result);
     }
 
     if (!result.hasCollision) {
         contact->SetEnabled(false);
-        std::cout << "[PreSolve] Contacto deshabilitado por detección personalizada" << std::endl;
+        if (m_logContacts) {
+            std::cout << "[PreSolve] Contacto deshabilitado por detección personalizada" << std::endl;
+        }
         return;
     }
 
-    std::cout << "[PreSolve] Colisión confirmada - Profundidad: " << result.depth
-              << " Normal: (" << result.normal.x << ", " << result.normal.y << ")"
-              << std::endl;
+    if (m_logContacts) {
+        std::cout << "[PreSolve] Colisión confirmada - Profundidad: " << result.depth
+                  << " Normal: (" << result.normal.x << ", " << result.normal.y << ")"
+                  << std::endl;
+    }
 
     b2WorldManifold worldManifold;
     contact->GetWorldManifold(&worldManifold);
@@ -99,13 +476,16 @@ void PhysicsWrapper::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
         bool shouldContinue = m_preSolveCallback(fixtureA, fixtureB, result);
         if (!shouldContinue) {
             contact->SetEnabled(false);
-            std::cout << "[PreSolve] Contacto deshabilitado por callback" << std::endl;
+            if (m_logContacts) {
+                std::cout << "[PreSolve] Contacto deshabilitado por callback" << std::endl;
+            }
         }
     }
 }
 
 void PhysicsWrapper::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) {
-    if (!m_postSolveCallback) {
+    const ParticleConfig& particleConfig = m_particles.GetConfig();
+    if (!m_postSolveCallback && !particleConfig.spawnOnImpact) {
         return;
     }
 
@@ -119,115 +499,631 @@ void PhysicsWrapper::PostSolve(b2Contact* contact, const b2ContactImpulse* impul
     }
 
     // Log para colisiones fuertes
-    if (totalImpulse > 10.0f) {
+    if (m_logContacts && totalImpulse > 10.0f) {
         std::cout << "[PostSolve] Colisión fuerte detectada! Impulso: " << totalImpulse << std::endl;
     }
 
-    m_postSolveCallback(fixtureA, fixtureB, impulse);
+    // Escombros en el punto de contacto, en proporción al impulso
+    if (particleConfig.spawnOnImpact && totalImpulse > particleConfig.spawnImpulseThreshold && impulse->count > 0) {
+        b2WorldManifold worldManifold;
+        contact->GetWorldManifold(&worldManifold);
+
+        b2Vec2 point = b2Vec2_zero;
+        for (int i = 0; i < impulse->count; ++i) {
+            point += worldManifold.points[i];
+        }
+        point *= 1.0f / impulse->count;
+
+        int32_t count = static_cast<int32_t>(totalImpulse * particleConfig.particlesPerImpulse);
+        count = std::min(count, particleConfig.maxParticlesPerImpact);
+        m_particles.Emit(point, -worldManifold.normal, count, particleConfig.spawnSpeed, b2_pi);
+    }
+
+    if (m_postSolveCallback) {
+        m_postSolveCallback(fixtureA, fixtureB, impulse);
+    }
 }
 
 ContactInfo PhysicsWrapper::PerformCustomCollisionCheck(b2Fixture* fixtureA, b2Fixture* fixtureB,
                                                         const b2Transform& xfA, const b2Transform& xfB) {
-    ContactInfo result;
+    const b2Shape* shapeA = fixtureA->GetShape();
+    const b2Shape* shapeB = fixtureB->GetShape();
+    ShapeSlot slotA = GetShapeSlot(shapeA);
+    ShapeSlot slotB = GetShapeSlot(shapeB);
+
+    if (m_logContacts && (slotA == e_slotOther || slotB == e_slotOther)) {
+        std::cout << "BOX2D" << std::endl;
+    }
+    return kCollisionKernels[slotA][slotB](shapeA, xfA, shapeB, xfB);
+}
+
+void PhysicsWrapper::SweepBullets(float deltaTime) {
+    m_bulletHits.clear();
+
+    Circle bulletCircle, otherCircle;
+    Polygon& bulletPolygon = m_bulletPolygon;
+    Polygon& otherPolygon = m_obstaclePolygon;
 
-    b2Shape::Type typeA = fixtureA->GetType();
-    b2Shape::Type typeB = fixtureB->GetType();
+    for (b2Body* bullet : m_bullets) {
+        if (!bullet->IsAwake() || !bullet->IsEnabled()) {
+            continue;
+        }
+
+        b2Sweep bulletSweep = MakeSweep(bullet, deltaTime);
+        b2Transform xf0, xf1;
+        bulletSweep.GetTransform(&xf0, 0.0f);
+        bulletSweep.GetTransform(&xf1, 1.0f);
 
-    if (typeA == b2Shape::e_circle && typeB == b2Shape::e_circle) {
-        const b2CircleShape* circleA = static_cast<const b2CircleShape*>(fixtureA->GetShape());
-        const b2CircleShape* circleB = static_cast<const b2CircleShape*>(fixtureB->GetShape());
+        // AABB barrido de todo el cuerpo
+        b2AABB swept;
+        bool hasShape = false;
+        for (b2Fixture* fixture = bullet->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+            b2AABB a0, a1;
+            fixture->GetShape()->ComputeAABB(&a0, xf0, 0);
+            fixture->GetShape()->ComputeAABB(&a1, xf1, 0);
+            a0.Combine(a1);
+            if (hasShape) {
+                swept.Combine(a0);
+            } else {
+                swept = a0;
+                hasShape = true;
+            }
+        }
+        if (!hasShape) {
+            continue;
+        }
 
-        Circle cA = {
-            b2Mul(xfA, circleA->m_p),
-            circleA->m_radius
-        };
-        Circle cB = {
-            b2Mul(xfB, circleB->m_p),
-            circleB->m_radius
-        };
+        m_sweepFixtures.clear();
+        QueryAABB(swept, m_sweepFixtures);
 
-        result = Collision::CheckCircleToCircle(cA, cB);
+        BulletHit earliest = { nullptr, nullptr, ContactInfo() };
+        float earliestT = 1.0f;
+
+        for (b2Fixture* bulletFixture = bullet->GetFixtureList(); bulletFixture; bulletFixture = bulletFixture->GetNext()) {
+            bool bulletIsCircle;
+            if (bulletFixture->IsSensor() || !GetLocalShape(bulletFixture, bulletCircle, bulletPolygon, bulletIsCircle)) {
+                continue;
+            }
+
+            for (b2Fixture* other : m_sweepFixtures) {
+                bool otherIsCircle;
+                if (other->GetBody() == bullet || other->IsSensor() || !ShouldCollide(bulletFixture, other) ||
+                    !GetLocalShape(other, otherCircle, otherPolygon, otherIsCircle)) {
+                    continue;
+                }
+
+                b2Sweep otherSweep = MakeSweep(other->GetBody(), deltaTime);
+                TOIResult toi;
+                bool flipped = false;
+                if (bulletIsCircle && otherIsCircle) {
+                    toi = Collision::TimeOfImpact(bulletCircle, bulletSweep, otherCircle, otherSweep);
+                } else if (bulletIsCircle) {
+                    toi = Collision::TimeOfImpact(bulletCircle, bulletSweep, otherPolygon, otherSweep);
+                } else if (otherIsCircle) {
+                    toi = Collision::TimeOfImpact(otherCircle, otherSweep, bulletPolygon, bulletSweep);
+                    flipped = true;
+                } else {
+                    toi = Collision::TimeOfImpact(bulletPolygon, bulletSweep, otherPolygon, otherSweep);
+                }
+
+                // Un impacto en t = 0 es un fixture que la bala ya toca (el
+                // suelo sobre el que rueda): de ese contacto se ocupa Box2D, y
+                // tomarlo como el primero dejaría la bala clavada en su sitio
+                if (toi.hit && toi.t > 0.0f && toi.t < earliestT) {
+                    earliestT = toi.t;
+                    earliest.bullet = bulletFixture;
+                    earliest.other = other;
+                    earliest.info.hasCollision = true;
+                    earliest.info.normal = flipped ? -toi.normal : toi.normal;
+                    earliest.info.depth = 0.0f;
+                    earliest.info.contactPoint = toi.contactPoint;
+                }
+            }
+        }
+
+        if (!earliest.bullet) {
+            continue;
+        }
+
+        // Detener la bala en el impacto; conserva la velocidad para que el
+        // solver de Box2D resuelva el contacto en este mismo Step
+        if (earliestT > 0.0f) {
+            b2Transform xf;
+            bulletSweep.GetTransform(&xf, earliestT);
+            bullet->SetTransform(xf.p, bulletSweep.a0 + earliestT * (bulletSweep.a - bulletSweep.a0));
+        }
+        m_bulletHits.push_back(earliest);
     }
-    // Polígono vs Polígono
-    else if (typeA == b2Shape::e_polygon && typeB == b2Shape::e_polygon) {
-        const b2PolygonShape* polyA = static_cast<const b2PolygonShape*>(fixtureA->GetShape());
-        const b2PolygonShape* polyB = static_cast<const b2PolygonShape*>(fixtureB->GetShape());
+}
 
-        Polygon pA, pB;
+bool PhysicsWrapper::FindBulletHit(b2Fixture* fixtureA, b2Fixture* fixtureB, ContactInfo& info) const {
+    for (const BulletHit& hit : m_bulletHits) {
+        bool bulletIsA = hit.bullet == fixtureA && hit.other == fixtureB;
+        bool bulletIsB = hit.bullet == fixtureB && hit.other == fixtureA;
+        if (!bulletIsA && !bulletIsB) {
+            continue;
+        }
 
-        pA.vertices.reserve(polyA->m_count);
-        for (int i = 0; i < polyA->m_count; ++i) {
-            pA.vertices.push_back(b2Mul(xfA, polyA->m_vertices[i]));
+        // De A hacia B, salvo círculo contra polígono: ahí
+        // PerformCustomCollisionCheck da la normal de B hacia A
+        info = hit.info;
+        bool mixed = (fixtureA->GetType() == b2Shape::e_circle) != (fixtureB->GetType() == b2Shape::e_circle);
+        if (bulletIsB != mixed) {
+            info.normal = -info.normal;
         }
-        pA.ComputeNormals();
+        return true;
+    }
+    return false;
+}
 
-        pB.vertices.reserve(polyB->m_count);
-        for (int i = 0; i < polyB->m_count; ++i) {
-            pB.vertices.push_back(b2Mul(xfB, polyB->m_vertices[i]));
+const TrajectoryPrediction& PhysicsWrapper::PredictTrajectory(b2Body* body, const b2Vec2& launchVelocity,
+                                                              float duration, int32 segments) {
+    segments = std::max<int32>(segments, 1);
+
+    const TrajectoryKey& key = m_trajectoryKey;
+    bool stale = !key.valid || key.body != body || key.duration != duration || key.segments != segments ||
+                 (key.velocity - launchVelocity).Length() > m_trajectoryTolerance ||
+                 (key.origin - body->GetWorldCenter()).Length() > b2_linearSlop;
+
+    if (stale) {
+        ComputeTrajectory(body, launchVelocity, duration, segments);
+        m_trajectoryKey.body = body;
+        m_trajectoryKey.origin = body->GetWorldCenter();
+        m_trajectoryKey.velocity = launchVelocity;
+        m_trajectoryKey.duration = duration;
+        m_trajectoryKey.segments = segments;
+        m_trajectoryKey.valid = true;
+    }
+    return m_trajectory;
+}
+
+void PhysicsWrapper::ComputeTrajectory(b2Body* body, const b2Vec2& launchVelocity, float duration, int32 segments) {
+    TrajectoryPrediction& trajectory = m_trajectory;
+    trajectory.points.clear();
+    trajectory.hit = false;
+    trajectory.hitFixture = nullptr;
+
+    // p(t) = p0 + v t + g t^2 / 2; sin amortiguamiento ni límite de
+    // traslación por paso, igual que un lanzamiento normal en este juego
+    const b2Vec2 origin = body->GetWorldCenter();
+    const b2Vec2 gravity = body->GetGravityScale() * m_world->GetGravity();
+    const float dt = duration / segments;
+
+    b2AABB bounds;
+    bounds.lowerBound = origin;
+    bounds.upperBound = origin;
+    for (int32 i = 0; i <= segments; ++i) {
+        float t = i * dt;
+        b2Vec2 p = origin + t * launchVelocity + (0.5f * t * t) * gravity;
+        trajectory.points.push_back(p);
+        bounds.lowerBound = b2Min(bounds.lowerBound, p);
+        bounds.upperBound = b2Max(bounds.upperBound, p);
+    }
+
+    // El cuerpo se barre como su círculo envolvente (exacto para el pájaro)
+    const b2Vec2 localCenter = body->GetLocalCenter();
+    Circle probe = { b2Vec2_zero, 0.0f };
+    bool hasShape = false;
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        if (fixture->IsSensor()) {
+            continue;
+        }
+        if (fixture->GetType() == b2Shape::e_circle) {
+            const b2CircleShape* shape = static_cast<const b2CircleShape*>(fixture->GetShape());
+            probe.radius = std::max(probe.radius, (shape->m_p - localCenter).Length() + shape->m_radius);
+            hasShape = true;
+        } else if (fixture->GetType() == b2Shape::e_polygon) {
+            const b2PolygonShape* shape = static_cast<const b2PolygonShape*>(fixture->GetShape());
+            for (int32 i = 0; i < shape->m_count; ++i) {
+                probe.radius = std::max(probe.radius, (shape->m_vertices[i] - localCenter).Length() + shape->m_radius);
+            }
+            hasShape = true;
+        }
+    }
+    if (!hasShape) {
+        return;
+    }
+
+    const b2Vec2 extent(probe.radius, probe.radius);
+    bounds.lowerBound -= extent;
+    bounds.upperBound += extent;
+
+    // Una sola consulta al broadphase para todo el arco
+    m_sweepFixtures.clear();
+    QueryAABB(bounds, m_sweepFixtures);
+
+    auto isObstacle = [body](b2Fixture* other) {
+        if (other->GetBody() == body || other->IsSensor()) {
+            return false;
+        }
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+            if (!fixture->IsSensor() && ShouldCollide(fixture, other)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    m_sweepFixtures.erase(std::remove_if(m_sweepFixtures.begin(), m_sweepFixtures.end(),
+                                         [&](b2Fixture* other) { return !isObstacle(other); }),
+                          m_sweepFixtures.end());
+
+    Circle otherCircle;
+    Polygon otherPolygon;
+
+    for (int32 i = 0; i < segments; ++i) {
+        const b2Vec2 p0 = trajectory.points[i];
+        const b2Vec2 p1 = trajectory.points[i + 1];
+
+        b2AABB segmentBounds;
+        segmentBounds.lowerBound = b2Min(p0, p1) - extent;
+        segmentBounds.upperBound = b2Max(p0, p1) + extent;
+
+        b2Sweep sweep;
+        sweep.localCenter = b2Vec2_zero;
+        sweep.c0 = p0;
+        sweep.c = p1;
+        sweep.a0 = 0.0f;
+        sweep.a = 0.0f;
+        sweep.alpha0 = 0.0f;
+
+        TOIResult earliest;
+        b2Fixture* hitFixture = nullptr;
+
+        for (b2Fixture* other : m_sweepFixtures) {
+            bool otherIsCircle;
+            if (!b2TestOverlap(segmentBounds, other->GetAABB(0)) ||
+                !GetLocalShape(other, otherCircle, otherPolygon, otherIsCircle)) {
+                continue;
+            }
+
+            b2Sweep otherSweep = MakeSweep(other->GetBody(), 0.0f);
+            TOIResult toi = otherIsCircle ? Collision::TimeOfImpact(probe, sweep, otherCircle, otherSweep)
+                                          : Collision::TimeOfImpact(probe, sweep, otherPolygon, otherSweep);
+
+            // Al arrancar el cuerpo puede estar apoyado en algo; ignorar los
+            // contactos iniciales de los que se aleja
+            if (!toi.hit || (toi.t == 0.0f && b2Dot(p1 - p0, toi.normal) <= 0.0f)) {
+                continue;
+            }
+            if (!hitFixture || toi.t < earliest.t) {
+                earliest = toi;
+                hitFixture = other;
+            }
         }
-        pB.ComputeNormals();
 
-        result = Collision::CheckPolygonToPolygon(pA, pB);
+        if (hitFixture) {
+            trajectory.points.resize(i + 2);
+            trajectory.points[i + 1] = p0 + earliest.t * (p1 - p0);
+            trajectory.hit = true;
+            trajectory.hitPoint = earliest.contactPoint;
+            trajectory.hitNormal = -earliest.normal;
+            trajectory.hitFixture = hitFixture;
+            return;
+        }
     }
-    else if (typeA == b2Shape::e_circle && typeB == b2Shape::e_polygon) {
-        const b2CircleShape* circle = static_cast<const b2CircleShape*>(fixtureA->GetShape());
-        const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(fixtureB->GetShape());
+}
 
-        Circle c = {
-            b2Mul(xfA, circle->m_p),
-            circle->m_radius
-        };
+void PhysicsWrapper::PrecomputeCircleContacts() {
+    CircleBatch& batch = m_circleBatch;
+    batch.circleContacts.clear();
+    batch.ax.clear(); batch.ay.clear(); batch.ar.clear();
+    batch.bx.clear(); batch.by.clear(); batch.br.clear();
+    batch.polygonPairs.clear();
 
-        Polygon p;
-        p.vertices.reserve(poly->m_count);
-        for (int i = 0; i < poly->m_count; ++i) {
-            p.vertices.push_back(b2Mul(xfB, poly->m_vertices[i]));
+    // Las transformaciones antes del Step son las que verá PreSolve
+    for (b2Contact* contact = m_world->GetContactList(); contact; contact = contact->GetNext()) {
+        b2Fixture* fixtureA = contact->GetFixtureA();
+        b2Fixture* fixtureB = contact->GetFixtureB();
+        b2Body* bodyA = fixtureA->GetBody();
+        b2Body* bodyB = fixtureB->GetBody();
+        if (!bodyA->IsAwake() && !bodyB->IsAwake()) {
+            continue;
         }
-        p.ComputeNormals();
 
-        result = Collision::CheckCircleToPolygon(c, p);
+        b2Shape::Type typeA = fixtureA->GetType();
+        b2Shape::Type typeB = fixtureB->GetType();
+
+        if (typeA == b2Shape::e_circle && typeB == b2Shape::e_circle) {
+            const b2CircleShape* circleA = static_cast<const b2CircleShape*>(fixtureA->GetShape());
+            const b2CircleShape* circleB = static_cast<const b2CircleShape*>(fixtureB->GetShape());
+            b2Vec2 cA = b2Mul(bodyA->GetTransform(), circleA->m_p);
+            b2Vec2 cB = b2Mul(bodyB->GetTransform(), circleB->m_p);
+
+            batch.circleContacts.push_back(contact);
+            batch.ax.push_back(cA.x); batch.ay.push_back(cA.y); batch.ar.push_back(circleA->m_radius);
+            batch.bx.push_back(cB.x); batch.by.push_back(cB.y); batch.br.push_back(circleB->m_radius);
+        } else if (typeA == b2Shape::e_circle && typeB == b2Shape::e_polygon) {
+            const b2CircleShape* circle = static_cast<const b2CircleShape*>(fixtureA->GetShape());
+            b2Vec2 c = b2Mul(bodyA->GetTransform(), circle->m_p);
+            batch.polygonPairs.push_back({ fixtureB, contact, false, c.x, c.y, circle->m_radius });
+        } else if (typeA == b2Shape::e_polygon && typeB == b2Shape::e_circle) {
+            const b2CircleShape* circle = static_cast<const b2CircleShape*>(fixtureB->GetShape());
+            b2Vec2 c = b2Mul(bodyB->GetTransform(), circle->m_p);
+            batch.polygonPairs.push_back({ fixtureA, contact, true, c.x, c.y, circle->m_radius });
+        }
+    }
+
+    if (batch.circleContacts.size() + batch.polygonPairs.size() < m_circleBatchThreshold) {
+        return; // Pocos círculos: PreSolve los resuelve uno a uno como siempre
+    }
+
+    size_t maxBatch = std::max(batch.circleContacts.size(), batch.polygonPairs.size());
+    if (batch.results.size() < maxBatch) {
+        batch.results.resize(maxBatch);
+    }
+
+    // Círculo vs círculo: un único lote
+    int32 circleCount = static_cast<int32>(batch.circleContacts.size());
+    Collision::CheckCirclesToCircles(batch.ax.data(), batch.ay.data(), batch.ar.data(),
+                                     batch.bx.data(), batch.by.data(), batch.br.data(),
+                                     circleCount, batch.results.data());
+    for (int32 i = 0; i < circleCount; ++i) {
+        m_contactCache.Insert(batch.circleContacts[i], batch.results[i]);
     }
-    else if (typeA == b2Shape::e_polygon && typeB == b2Shape::e_circle) {
-        const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(fixtureA->GetShape());
-        const b2CircleShape* circle = static_cast<const b2CircleShape*>(fixtureB->GetShape());
 
-        Polygon p;
-        p.vertices.reserve(poly->m_count);
-        for (int i = 0; i < poly->m_count; ++i) {
-            p.vertices.push_back(b2Mul(xfA, poly->m_vertices[i]));
+    // Círculo vs polígono: un lote por polígono (p.ej. todos los pájaros sobre el suelo)
+    std::sort(batch.polygonPairs.begin(), batch.polygonPairs.end(),
+              [](const CircleBatch::PolygonPair& a, const CircleBatch::PolygonPair& b) {
+                  return a.polygon < b.polygon;
+              });
+
+    size_t runStart = 0;
+    while (runStart < batch.polygonPairs.size()) {
+        b2Fixture* fixture = batch.polygonPairs[runStart].polygon;
+        size_t runEnd = runStart;
+        batch.ax.clear(); batch.ay.clear(); batch.ar.clear();
+        while (runEnd < batch.polygonPairs.size() && batch.polygonPairs[runEnd].polygon == fixture) {
+            batch.ax.push_back(batch.polygonPairs[runEnd].x);
+            batch.ay.push_back(batch.polygonPairs[runEnd].y);
+            batch.ar.push_back(batch.polygonPairs[runEnd].radius);
+            ++runEnd;
         }
-        p.ComputeNormals();
 
-        Circle c = {
-            b2Mul(xfB, circle->m_p),
-            circle->m_radius
-        };
+        // Los mismos vértices y ejes SAT que cargaría el kernel de ese slot
+        const b2PolygonShape* poly = static_cast<const b2PolygonShape*>(fixture->GetShape());
+        const b2Transform& xf = fixture->GetBody()->GetTransform();
+        Polygon& polygon = batch.polygon;
+        polygon.vertices.clear();
+        for (int32 i = 0; i < poly->m_count; ++i) {
+            polygon.vertices.push_back(b2Mul(xf, poly->m_vertices[i]));
+        }
+        ShapeSlot slot = GetShapeSlot(poly);
+        if (slot == e_slotPolygon) {
+            polygon.ComputeNormals();
+        } else {
+            int32 axisCount = slot == e_slotBox ? 2 : poly->m_count;
+            polygon.normals.clear();
+            for (int32 i = 0; i < axisCount; ++i) {
+                polygon.normals.push_back(b2Mul(xf.q, poly->m_normals[i]));
+            }
+        }
 
-        result = Collision::CheckCircleToPolygon(c, p);
+        int32 runCount = static_cast<int32>(runEnd - runStart);
+        Collision::CheckCirclesToPolygon(batch.ax.data(), batch.ay.data(), batch.ar.data(), runCount,
+                                         polygon.vertices.data(), static_cast<int32>(polygon.vertices.size()),
+                                         polygon.normals.data(), static_cast<int32>(polygon.normals.size()),
+                                         batch.results.data());
 
-        if (result.hasCollision) {
-            result.normal = -result.normal;
+        for (int32 i = 0; i < runCount; ++i) {
+            const CircleBatch::PolygonPair& pair = batch.polygonPairs[runStart + i];
+            ContactInfo& result = batch.results[i];
+            // Misma convención que PerformCustomCollisionCheck
+            if (pair.polygonIsA && result.hasCollision) {
+                result.normal = -result.normal;
+            }
+            m_contactCache.Insert(pair.contact, result);
         }
+
+        runStart = runEnd;
     }
-    else {
-        std::cout<<"BOX2D"<<std::endl;
-        // Para otros tipos de formas (edge, chain), usar detección de Box2D
-        result.hasCollision = true;
+}
+
+bool PhysicsWrapper::StartRecording(const std::string& path, const RecorderConfig& config) {
+    if (!m_recorder.Start(path, config)) {
+        return false;
+    }
+
+    // La lista de Box2D va del más nuevo al más viejo; los ids siguen el orden de creación
+    std::vector<b2Body*> bodies;
+    for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext()) {
+        bodies.push_back(body);
+    }
+    for (auto it = bodies.rbegin(); it != bodies.rend(); ++it) {
+        m_recorder.RegisterBody(*it);
     }
+    return true;
+}
 
-    return result;
+void PhysicsWrapper::StopRecording() {
+    m_recorder.Stop();
 }
 
 b2Body* PhysicsWrapper::CreateBody(const b2BodyDef* def) {
-    return m_world->CreateBody(def);
+    b2Body* body = m_world->CreateBody(def);
+    InvalidateTrajectory();
+    m_recorder.RegisterBody(body);
+    if (m_regions) {
+        m_regions->RegisterBody(body);
+    }
+    if (def->bullet) {
+        m_bullets.push_back(body);
+    }
+    return body;
 }
 
 void PhysicsWrapper::DestroyBody(b2Body* body) {
     if (body) {
+        // Antes de nada: quien guarde el puntero (la lista del nivel) lo suelta
+        if (m_bodyDestroyedCallback) {
+            m_bodyDestroyedCallback(body);
+        }
+        if (m_regions) {
+            m_regions->UnregisterBody(body);
+        }
+        m_bullets.erase(std::remove(m_bullets.begin(), m_bullets.end(), body), m_bullets.end());
+        m_recorder.UnregisterBody(body);
+        InvalidateTrajectory();
+
+        auto handle = m_bodyHandles.find(body);
+        if (handle != m_bodyHandles.end()) {
+            m_handleBodies.erase(handle->second);
+            m_bodyHandles.erase(handle);
+        }
         m_world->DestroyBody(body);
     }
 }
 
+BodyHandle PhysicsWrapper::EnqueueCreateBody(const BodySpawn& spawn) {
+    PhysicsCommand command;
+    command.type = PhysicsCommand::e_createBody;
+    command.handle = m_commands.AllocateHandle();
+    command.spawn = spawn;
+    return m_commands.Enqueue(command) ? command.handle : BodyHandle();
+}
+
+bool PhysicsWrapper::EnqueueDestroyBody(BodyHandle handle) {
+    PhysicsCommand command;
+    command.type = PhysicsCommand::e_destroyBody;
+    command.handle = handle;
+    return m_commands.Enqueue(command);
+}
+
+bool PhysicsWrapper::EnqueueSetLinearVelocity(BodyHandle handle, const b2Vec2& velocity) {
+    PhysicsCommand command;
+    command.type = PhysicsCommand::e_setLinearVelocity;
+    command.handle = handle;
+    command.vector = velocity;
+    return m_commands.Enqueue(command);
+}
+
+bool PhysicsWrapper::EnqueueApplyLinearImpulse(BodyHandle handle, const b2Vec2& impulse) {
+    PhysicsCommand command;
+    command.type = PhysicsCommand::e_applyLinearImpulse;
+    command.handle = handle;
+    command.vector = impulse;
+    return m_commands.Enqueue(command);
+}
+
+bool PhysicsWrapper::EnqueueSetCollisionFilter(BodyHandle handle, uint16_t category, uint16_t mask) {
+    PhysicsCommand command;
+    command.type = PhysicsCommand::e_setCollisionFilter;
+    command.handle = handle;
+    command.categoryBits = category;
+    command.maskBits = mask;
+    return m_commands.Enqueue(command);
+}
+
+BodyHandle PhysicsWrapper::GetBodyHandle(b2Body* body) {
+    BodyHandle handle;
+    auto it = m_bodyHandles.find(body);
+    if (it != m_bodyHandles.end()) {
+        handle.id = it->second;
+        return handle;
+    }
+
+    handle = m_commands.AllocateHandle();
+    m_bodyHandles[body] = handle.id;
+    m_handleBodies[handle.id] = body;
+    return handle;
+}
+
+b2Body* PhysicsWrapper::ResolveBodyHandle(BodyHandle handle) const {
+    auto it = m_handleBodies.find(handle.id);
+    return it != m_handleBodies.end() ? it->second : nullptr;
+}
+
+CommandStats PhysicsWrapper::GetCommandStats() const {
+    CommandStats stats;
+    stats.enqueued = m_commands.GetEnqueuedCount();
+    stats.dropped = m_commands.GetDroppedCount();
+    stats.applied = m_commandsApplied;
+    stats.orphaned = m_commandsOrphaned;
+    return stats;
+}
+
+void PhysicsWrapper::ApplyCommands() {
+    // Como mucho una vuelta de la cola, para que un productor rápido no
+    // retrase el Step indefinidamente
+    PhysicsCommand command;
+    for (size_t budget = m_commands.GetCapacity(); budget > 0 && m_commands.Dequeue(command); --budget) {
+        if (command.type == PhysicsCommand::e_createBody) {
+            b2Body* body = SpawnBody(command.spawn);
+            m_bodyHandles[body] = command.handle.id;
+            m_handleBodies[command.handle.id] = body;
+            ++m_commandsApplied;
+            continue;
+        }
+
+        b2Body* body = ResolveBodyHandle(command.handle);
+        if (!body) {
+            ++m_commandsOrphaned;
+            continue;
+        }
+
+        switch (command.type) {
+            case PhysicsCommand::e_destroyBody:
+                DestroyBody(body);
+                break;
+            case PhysicsCommand::e_setLinearVelocity:
+                body->SetLinearVelocity(command.vector);
+                body->SetAwake(true);
+                break;
+            case PhysicsCommand::e_applyLinearImpulse:
+                body->ApplyLinearImpulseToCenter(command.vector, true);
+                break;
+            case PhysicsCommand::e_setCollisionFilter:
+                // Los handles son de cuerpo: el filtro se aplica a todos sus fixtures
+                for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+                    SetCollisionFilter(fixture, command.categoryBits, command.maskBits);
+                }
+                break;
+            default:
+                break;
+        }
+        ++m_commandsApplied;
+    }
+}
+
+b2Body* PhysicsWrapper::SpawnBody(const BodySpawn& spawn) {
+    b2BodyDef def;
+    def.type = spawn.type;
+    def.position = spawn.position;
+    def.angle = spawn.angle;
+    def.linearVelocity = spawn.linearVelocity;
+    def.angularVelocity = spawn.angularVelocity;
+    def.bullet = spawn.bullet;
+    b2Body* body = CreateBody(&def);
+
+    b2CircleShape circle;
+    b2PolygonShape polygon;
+    b2FixtureDef fixtureDef;
+    switch (spawn.shape) {
+        case BodySpawn::e_circle:
+            circle.m_radius = spawn.radius;
+            fixtureDef.shape = &circle;
+            break;
+        case BodySpawn::e_box:
+            polygon.SetAsBox(spawn.halfExtents.x, spawn.halfExtents.y);
+            fixtureDef.shape = &polygon;
+            break;
+        case BodySpawn::e_polygon:
+            if (!SetPolygonChecked(polygon, spawn.vertices, std::min<int32>(spawn.vertexCount, b2_maxPolygonVertices))) {
+                std::cerr << "[PhysicsWrapper] Polígono encolado no válido; se usa una caja" << std::endl;
+                polygon.SetAsBox(spawn.halfExtents.x, spawn.halfExtents.y);
+            }
+            fixtureDef.shape = &polygon;
+            break;
+    }
+    fixtureDef.density = spawn.density;
+    fixtureDef.friction = spawn.friction;
+    fixtureDef.restitution = spawn.restitution;
+    fixtureDef.filter.categoryBits = spawn.categoryBits;
+    fixtureDef.filter.maskBits = spawn.maskBits;
+    body->CreateFixture(&fixtureDef);
+
+    return body;
+}
+
 b2Fixture* PhysicsWrapper::CreatePolygonFixture(b2Body* body, const b2PolygonShape* shape, float density) {
     b2FixtureDef fixtureDef;
     fixtureDef.shape = shape;
@@ -255,6 +1151,34 @@ b2Fixture* PhysicsWrapper::CreateBoxFixture(b2Body* body, float halfWidth, float
     return CreatePolygonFixture(body, &box, density);
 }
 
+void PhysicsWrapper::SetBullet(b2Body* body, bool bullet) {
+    body->SetBullet(bullet);
+    auto it = std::find(m_bullets.begin(), m_bullets.end(), body);
+    if (bullet && it == m_bullets.end()) {
+        m_bullets.push_back(body);
+    } else if (!bullet && it != m_bullets.end()) {
+        m_bullets.erase(it);
+    }
+}
+
+std::vector<b2Fixture*> PhysicsWrapper::CreateConcaveFixtures(b2Body* body, const b2Vec2* vertices, int32 count, float density) {
+    std::vector<b2Fixture*> fixtures;
+    const std::vector<ConvexPiece>* pieces = m_decomposer.Decompose(vertices, count);
+    if (!pieces) {
+        return fixtures;
+    }
+
+    fixtures.reserve(pieces->size());
+    for (const ConvexPiece& piece : *pieces) {
+        b2PolygonShape shape;
+        if (!SetPolygonChecked(shape, piece.vertices, piece.count)) {
+            continue; // Pieza demasiado pequeña para Box2D
+        }
+        fixtures.push_back(CreatePolygonFixture(body, &shape, density));
+    }
+    return fixtures;
+}
+
 void PhysicsWrapper::SetCollisionFilter(b2Fixture* fixture, uint16_t category, uint16_t mask) {
     b2Filter filter;
     filter.categoryBits = category;
@@ -263,11 +1187,38 @@ void PhysicsWrapper::SetCollisionFilter(b2Fixture* fixture, uint16_t category, u
 }
 
 void PhysicsWrapper::SetDebugDraw(b2Draw* debugDraw) {
+    m_debugDraw = debugDraw;
     m_world->SetDebugDraw(debugDraw);
 }
 
 void PhysicsWrapper::DrawDebugData() {
+    if (!m_debugDraw) {
+        return;
+    }
+
     m_world->DebugDraw();
+
+    if (m_debugDraw->GetFlags() & e_contactInfoBit) {
+        DrawContactInfos();
+    }
+}
+
+void PhysicsWrapper::DrawContactInfos() {
+    const b2Color pointColor(1.0f, 0.2f, 0.2f);
+    const b2Color normalColor(1.0f, 1.0f, 0.0f);
+    const b2Color depthColor(1.0f, 0.0f, 1.0f);
+    const float normalLength = 0.5f; // metros
+
+    // m_contactCache tiene los resultados del último Step
+    m_contactCache.ForEach([&](const b2Contact*, const ContactInfo& info) {
+        if (!info.hasCollision) {
+            return;
+        }
+
+        m_debugDraw->DrawPoint(info.contactPoint, 5.0f, pointColor);
+        m_debugDraw->DrawSegment(info.contactPoint, info.contactPoint + normalLength * info.normal, normalColor);
+        m_debugDraw->DrawSegment(info.contactPoint, info.contactPoint - info.depth * info.normal, depthColor);
+    });
 }
 
 void PhysicsWrapper::QueryAABB(const b2AABB& aabb, std::vector<b2Fixture*>& fixtures) {
@@ -290,4 +1241,38 @@ bool PhysicsWrapper::RayCast(const b2Vec2& start, const b2Vec2& end, b2RayCastOu
     }
 
     return false;
+}
+
+void PhysicsWrapper::EnableRegions(const b2AABB& bounds, float regionSize) {
+    DisableRegions();
+    m_regions = std::make_unique<RegionManager>(m_world.get(), bounds, regionSize);
+}
+
+void PhysicsWrapper::DisableRegions() {
+    if (m_regions) {
+        m_regions->ThawAll();
+        m_regions.reset();
+    }
+}
+
+void PhysicsWrapper::SetRegionFocusArea(const b2AABB& area) {
+    if (m_regions) {
+        m_regions->SetFocusArea(area);
+    }
+}
+
+void PhysicsWrapper::SetRegionFocusBody(b2Body* body) {
+    if (m_regions) {
+        m_regions->SetFocusBody(body);
+    }
+}
+
+void PhysicsWrapper::SetRegionMargins(float activeMargin, float freezeMargin) {
+    if (m_regions) {
+        m_regions->SetMargins(activeMargin, freezeMargin);
+    }
+}
+
+RegionStats PhysicsWrapper::GetRegionStats() const {
+    return m_regions ? m_regions->GetStats() : RegionStats();
 }
\ No newline at end of file
@@ -2,50 +2,162 @@
 #define PHYSICSWRAPPER_H
 
 #include <box2d/box2d.h>
+#include "CommandQueue.h"
+#include "ContactCache.h"
+#include "ConvexDecomposition.h"
+#include "ForceField.h"
+#include "MemoryTracker.h"
+#include "ParticleSystem.h"
+#include "RegionManager.h"
+#include "StateRecorder.h"
 #include <memory>
 #include <functional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 struct ContactInfo;
 
+// Trayectoria prevista de un lanzamiento; points son posiciones del centro
+// de masas en metros y el último es el del impacto si hit es true
+struct TrajectoryPrediction {
+    std::vector<b2Vec2> points;
+    bool hit = false;
+    b2Vec2 hitPoint = b2Vec2_zero;
+    b2Vec2 hitNormal = b2Vec2_zero; // Normal de la superficie alcanzada, hacia el cuerpo
+    b2Fixture* hitFixture = nullptr;
+};
+
 class PhysicsWrapper : public b2ContactListener {
 public:
     using ContactCallback = std::function<void(b2Fixture* fixtureA, b2Fixture* fixtureB)>;
     using PreSolveCallback = std::function<bool(b2Fixture* fixtureA, b2Fixture* fixtureB, const ContactInfo& info)>;
     using PostSolveCallback = std::function<void(b2Fixture* fixtureA, b2Fixture* fixtureB, const b2ContactImpulse* impulse)>;
+    using BodyCallback = std::function<void(b2Body* body)>;
 
     PhysicsWrapper(const b2Vec2& gravity = b2Vec2(0.0f, -9.8f));
     ~PhysicsWrapper();
 
     void Update(float deltaTime);
 
+    // Vuelve a un mundo vacío sin reconstruir el wrapper: destruye todos los
+    // cuerpos (con el aviso de SetBodyDestroyedCallback) y crea un b2World
+    // nuevo con la misma configuración, para que los ids del broadphase y el
+    // orden de los contactos sean los de un mundo recién hecho. Vacía
+    // partículas, campos de fuerza y balas, y desactiva las regiones. Se
+    // conservan los buffers reservados (partículas, cola de comandos,
+    // grabación), los callbacks y las opciones.
+    void ResetWorld();
+
     b2Body* CreateBody(const b2BodyDef* def);
     void DestroyBody(b2Body* body);
 
+    // Los cuerpos bala se barren con tiempo de impacto antes de cada Step
+    // para que la detección personalizada no los deje atravesar nada
+    void SetBullet(b2Body* body, bool bullet);
+
+    // Mutaciones desde otros hilos (IA, red). Se pueden llamar desde
+    // cualquier hilo: encolan sin bloqueos ni asignaciones y se aplican al
+    // principio del siguiente Update, antes del Step. Devuelven false (o un
+    // handle inválido) si la cola está llena. EnqueueDestroyBody invalida
+    // también los b2Body* que el hilo principal guarde de ese cuerpo.
+    BodyHandle EnqueueCreateBody(const BodySpawn& spawn);
+    bool EnqueueDestroyBody(BodyHandle handle);
+    bool EnqueueSetLinearVelocity(BodyHandle handle, const b2Vec2& velocity);
+    bool EnqueueApplyLinearImpulse(BodyHandle handle, const b2Vec2& impulse);
+    bool EnqueueSetCollisionFilter(BodyHandle handle, uint16_t category, uint16_t mask);
+
+    // Solo desde el hilo de Update: handle de un cuerpo ya existente (para
+    // pasarlo a otros hilos) y cuerpo de un handle (nullptr si aún no se ha
+    // creado o ya se destruyó)
+    BodyHandle GetBodyHandle(b2Body* body);
+    b2Body* ResolveBodyHandle(BodyHandle handle) const;
+    CommandStats GetCommandStats() const;
+
     b2Fixture* CreatePolygonFixture(b2Body* body, const b2PolygonShape* shape, float density = 1.0f);
     b2Fixture* CreateCircleFixture(b2Body* body, const b2CircleShape* shape, float density = 1.0f);
     b2Fixture* CreateBoxFixture(b2Body* body, float halfWidth, float halfHeight, float density = 1.0f);
+    // Polígono simple cualquiera (cóncavo o convexo, en coordenadas locales):
+    // se descompone en piezas convexas, una por fixture. La descomposición se
+    // cachea por contenido. Vacío si el polígono no es simple.
+    std::vector<b2Fixture*> CreateConcaveFixtures(b2Body* body, const b2Vec2* vertices, int32 count, float density = 1.0f);
+    ConvexDecomposer& GetDecomposer() { return m_decomposer; }
 
     void EnableCustomCollisionDetection(bool enable) { m_useCustomDetection = enable; }
     bool IsCustomCollisionDetectionEnabled() const { return m_useCustomDetection; }
 
+    // Traza por consola de cada contacto de la detección personalizada
+    // (activada por defecto). Escribir por contacto en cada paso cuesta más
+    // que la propia física: apagarla en pruebas, benchmarks y sin ventana.
+    void SetContactLogging(bool enable) { m_logContacts = enable; }
+    bool IsContactLoggingEnabled() const { return m_logContacts; }
+
+    // Pares con círculos a partir de los cuales se calculan en lote con SIMD
+    // antes del Step (8 por defecto). El resultado es el mismo que uno a uno:
+    // 1 lo fuerza siempre y SIZE_MAX lo desactiva.
+    void SetCircleBatchThreshold(size_t pairs) { m_circleBatchThreshold = pairs; }
+
     void SetCollisionFilter(b2Fixture* fixture, uint16_t category, uint16_t mask);
 
     void SetBeginContactCallback(ContactCallback callback) { m_beginContactCallback = callback; }
     void SetEndContactCallback(ContactCallback callback) { m_endContactCallback = callback; }
     void SetPreSolveCallback(PreSolveCallback callback) { m_preSolveCallback = callback; }
     void SetPostSolveCallback(PostSolveCallback callback) { m_postSolveCallback = callback; }
+    // Justo antes de destruir un cuerpo, también los de EnqueueDestroyBody:
+    // para soltar los punteros que el juego guarde a ese cuerpo
+    void SetBodyDestroyedCallback(BodyCallback callback) { m_bodyDestroyedCallback = callback; }
 
     b2World* GetWorld() { return m_world.get(); }
     const b2World* GetWorld() const { return m_world.get(); }
 
+    // Bit propio para b2Draw::SetFlags: dibuja normal, profundidad y punto de
+    // contacto de los ContactInfo calculados por la detección personalizada
+    static constexpr uint32 e_contactInfoBit = 0x0100;
+
     void SetDebugDraw(b2Draw* debugDraw);
     void DrawDebugData();
 
     void QueryAABB(const b2AABB& aabb, std::vector<b2Fixture*>& fixtures);
     bool RayCast(const b2Vec2& start, const b2Vec2& end, b2RayCastOutput& output, b2Fixture** hitFixture = nullptr);
 
+    // Explosiones, viento y pozos de gravedad; se aplican antes de cada Step
+    ForceFieldSystem& GetForceFields() { return m_forceFields; }
+    const ForceFieldSystem& GetForceFields() const { return m_forceFields; }
+
+    // Parábola analítica de body lanzado con launchVelocity (m/s), truncada en
+    // el primer impacto sin avanzar el mundo. Se cachea: solo se recalcula si
+    // la velocidad cambia más que la tolerancia, si el cuerpo se mueve o si se
+    // crean/destruyen cuerpos.
+    const TrajectoryPrediction& PredictTrajectory(b2Body* body, const b2Vec2& launchVelocity,
+                                                  float duration = 2.5f, int32 segments = 48);
+    void SetTrajectoryTolerance(float tolerance) { m_trajectoryTolerance = tolerance; }
+    void InvalidateTrajectory() { m_trajectoryKey.valid = false; }
+
+    // Escombros cosméticos; se emiten desde PostSolve en impactos fuertes
+    ParticleSystem& GetParticles() { return m_particles; }
+    const ParticleSystem& GetParticles() const { return m_particles; }
+
+    // Regiones: el mundo se divide en celdas de regionSize metros; las lejanas
+    // y en reposo se congelan hasta que algo entra en ellas
+    void EnableRegions(const b2AABB& bounds, float regionSize);
+    void DisableRegions();
+    bool AreRegionsEnabled() const { return m_regions != nullptr; }
+    void SetRegionFocusArea(const b2AABB& area);
+    void SetRegionFocusBody(b2Body* body);
+    void SetRegionMargins(float activeMargin, float freezeMargin);
+    RegionStats GetRegionStats() const;
+
+    // Graba pose y velocidad de cada cuerpo tras cada Step en un archivo
+    // .b2rec (leer con StateReader); la codificación va en otro hilo
+    bool StartRecording(const std::string& path, const RecorderConfig& config = RecorderConfig());
+    void StopRecording();
+    bool IsRecording() const { return m_recorder.IsRecording(); }
+    RecorderStats GetRecorderStats() const { return m_recorder.GetStats(); }
+
+    // Memoria viva/pico global y asignaciones hechas por este hilo durante el
+    // último Update (cero en una escena en reposo)
+    const MemoryStats& GetMemoryStats() const { return m_memoryStats; }
+
 protected:
     void BeginContact(b2Contact* contact) override;
     void EndContact(b2Contact* contact) override;
@@ -55,18 +167,102 @@ protected:
 private:
     ContactInfo PerformCustomCollisionCheck(b2Fixture* fixtureA, b2Fixture* fixtureB, const b2Transform& xfA, const b2Transform& xfB);
 
+    // Avanza cada bala hasta su primer impacto del paso (si lo hay) y anota el
+    // par para que PreSolve no deshabilite un contacto que aún no se solapa
+    void SweepBullets(float deltaTime);
+    bool FindBulletHit(b2Fixture* fixtureA, b2Fixture* fixtureB, ContactInfo& info) const;
+
+    struct BulletHit {
+        b2Fixture* bullet;
+        b2Fixture* other;
+        ContactInfo info; // Normal de la bala hacia el otro fixture
+    };
+
+    // Rellena m_contactCache antes del Step con los contactos círculo-círculo
+    // y círculo-polígono calculados en lote; PreSolve los encuentra ya hechos.
+    void PrecomputeCircleContacts();
+
+    // Buffers reutilizados por PrecomputeCircleContacts
+    struct CircleBatch {
+        struct PolygonPair {
+            b2Fixture* polygon;
+            b2Contact* contact;
+            bool polygonIsA;
+            float x, y, radius;
+        };
+
+        std::vector<b2Contact*> circleContacts;
+        std::vector<float> ax, ay, ar, bx, by, br;
+        std::vector<PolygonPair> polygonPairs;
+        std::vector<ContactInfo> results;
+        Polygon polygon; // Polígono de la tanda actual, en coordenadas del mundo
+    };
+
+    void DrawContactInfos();
+
+    // Aplica los comandos encolados hasta el momento de la llamada
+    void ApplyCommands();
+    b2Body* SpawnBody(const BodySpawn& spawn);
+
+    // Muestrea la parábola y la barre contra lo que devuelve una única
+    // consulta al broadphase sobre el AABB de todo el arco
+    void ComputeTrajectory(b2Body* body, const b2Vec2& launchVelocity, float duration, int32 segments);
+
+    // Parámetros con los que se calculó m_trajectory
+    struct TrajectoryKey {
+        b2Body* body = nullptr;
+        b2Vec2 origin = b2Vec2_zero;
+        b2Vec2 velocity = b2Vec2_zero;
+        float duration = 0.0f;
+        int32 segments = 0;
+        bool valid = false;
+    };
+
     std::unique_ptr<b2World> m_world;
     bool m_useCustomDetection;
+    bool m_logContacts;
+    b2Draw* m_debugDraw;
 
     ContactCallback m_beginContactCallback;
     ContactCallback m_endContactCallback;
     PreSolveCallback m_preSolveCallback;
     PostSolveCallback m_postSolveCallback;
+    BodyCallback m_bodyDestroyedCallback;
+
+    ContactCache m_contactCache;
+    CircleBatch m_circleBatch;
+    size_t m_circleBatchThreshold;
 
-    std::unordered_map<b2Contact*, ContactInfo> m_contactCache;
+    std::vector<b2Body*> m_bullets;
+    std::vector<BulletHit> m_bulletHits;
+    std::vector<b2Fixture*> m_sweepFixtures;
+    Polygon m_bulletPolygon;   // Formas locales reutilizadas por SweepBullets
+    Polygon m_obstaclePolygon;
+
+    TrajectoryPrediction m_trajectory;
+    TrajectoryKey m_trajectoryKey;
+    float m_trajectoryTolerance;
 
     int32_t m_velocityIterations;
     int32_t m_positionIterations;
+
+    MemoryStats m_memoryStats;
+
+    std::unique_ptr<RegionManager> m_regions;
+
+    ParticleSystem m_particles;
+
+    ForceFieldSystem m_forceFields;
+
+    ConvexDecomposer m_decomposer;
+
+    StateRecorder m_recorder;
+
+    CommandQueue m_commands;
+    std::unordered_map<uint64_t, b2Body*> m_handleBodies;
+    std::unordered_map<b2Body*, uint64_t> m_bodyHandles;
+    uint64_t m_commandsApplied;
+    uint64_t m_commandsOrphaned;
 };
 
 class AABBQueryCallback : public b2QueryCallback {
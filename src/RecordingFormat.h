@@ -0,0 +1,117 @@
+//
+// Formato de archivo .b2rec compartido por StateRecorder y StateReader.
+//
+// Todo en little-endian (se escribe la representación en memoria):
+//   Cabecera:  "B2RC", versión, keyframeInterval y los tres cuantos.
+//   Frame:     uint32 tamaño del payload y el payload:
+//                uint8 flags, uint64 paso, float tiempo, uint32 nº de ids,
+//                máscara de presencia (un bit por id) y, por cada cuerpo
+//                presente, seis enteros zigzag-varint con la diferencia
+//                cuantizada respecto al frame anterior (respecto a cero en
+//                los keyframes).
+//   Índice:    al cerrar, uint64 offset de cada frame, seguido de uint64
+//              offset del índice, uint64 nº de frames y "B2RI".
+//
+#ifndef RECORDINGFORMAT_H
+#define RECORDINGFORMAT_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Estado de un cuerpo en un paso
+struct BodyState {
+    float x = 0.0f;
+    float y = 0.0f;
+    float angle = 0.0f;
+    float vx = 0.0f;
+    float vy = 0.0f;
+    float angularVelocity = 0.0f;
+};
+
+namespace RecordingFormat {
+    const char kMagic[4] = { 'B', '2', 'R', 'C' };
+    const char kIndexMagic[4] = { 'B', '2', 'R', 'I' };
+    const uint32_t kVersion = 1;
+
+    const uint8_t kKeyframeFlag = 0x01;
+    const int kComponents = 6; // x, y, ángulo, vx, vy, velocidad angular
+
+    const size_t kHeaderSize = 4 + 4 * 5;
+    const size_t kFooterSize = 8 + 8 + 4;
+
+    struct Header {
+        uint32_t version = kVersion;
+        uint32_t keyframeInterval = 60;
+        float positionQuantum = 1.0f / 1024.0f; // metros
+        float angleQuantum = 1.0f / 4096.0f;    // radianes
+        float velocityQuantum = 1.0f / 256.0f;  // m/s y rad/s
+    };
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool Get(const uint8_t*& p, const uint8_t* end, T& value) {
+        if (static_cast<size_t>(end - p) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    inline uint32_t ZigZag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    inline int32_t UnZigZag(uint32_t value) {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+    inline void PutVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline bool GetVarint(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35 && p < end; shift += 7) {
+            uint8_t byte = *p++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline void Quantize(const BodyState& state, const Header& header, int32_t out[kComponents]) {
+        out[0] = static_cast<int32_t>(std::lround(state.x / header.positionQuantum));
+        out[1] = static_cast<int32_t>(std::lround(state.y / header.positionQuantum));
+        out[2] = static_cast<int32_t>(std::lround(state.angle / header.angleQuantum));
+        out[3] = static_cast<int32_t>(std::lround(state.vx / header.velocityQuantum));
+        out[4] = static_cast<int32_t>(std::lround(state.vy / header.velocityQuantum));
+        out[5] = static_cast<int32_t>(std::lround(state.angularVelocity / header.velocityQuantum));
+    }
+
+    inline BodyState Dequantize(const int32_t in[kComponents], const Header& header) {
+        BodyState state;
+        state.x = in[0] * header.positionQuantum;
+        state.y = in[1] * header.positionQuantum;
+        state.angle = in[2] * header.angleQuantum;
+        state.vx = in[3] * header.velocityQuantum;
+        state.vy = in[4] * header.velocityQuantum;
+        state.angularVelocity = in[5] * header.velocityQuantum;
+        return state;
+    }
+}
+
+#endif //RECORDINGFORMAT_H
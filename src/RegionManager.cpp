@@ -0,0 +1,346 @@
+#include "RegionManager.h"
+#include <algorithm>
+#include <cmath>
+
+RegionManager::RegionManager(b2World* world, const b2AABB& bounds, float regionSize)
+    : m_world(world)
+    , m_bounds(bounds)
+    , m_regionSize(regionSize > 0.0f ? regionSize : 1.0f)
+    , m_hasFocusArea(false)
+    , m_focusBody(nullptr)
+    , m_activeMargin(0.0f)
+    , m_freezeMargin(0.0f)
+    , m_freezeCheckInterval(30)
+    , m_tick(0) {
+
+    b2Vec2 extent = bounds.upperBound - bounds.lowerBound;
+    m_columns = std::max(1, static_cast<int32_t>(std::ceil(extent.x / m_regionSize)));
+    m_rows = std::max(1, static_cast<int32_t>(std::ceil(extent.y / m_regionSize)));
+
+    m_regions.resize(static_cast<size_t>(m_columns * m_rows));
+    m_activeRegions.reserve(m_regions.size());
+    for (int32_t y = 0; y < m_rows; ++y) {
+        for (int32_t x = 0; x < m_columns; ++x) {
+            Region& region = m_regions[static_cast<size_t>(y * m_columns + x)];
+            region.bounds.lowerBound = bounds.lowerBound + b2Vec2(x * m_regionSize, y * m_regionSize);
+            region.bounds.upperBound = region.bounds.lowerBound + b2Vec2(m_regionSize, m_regionSize);
+            m_activeRegions.push_back(y * m_columns + x);
+        }
+    }
+
+    // Registrar los cuerpos que ya existen; todas las regiones empiezan activas
+    // y se congelan en cuanto quedan fuera de foco y en reposo.
+    for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext()) {
+        RegisterBody(body);
+    }
+
+    m_stats.totalRegions = static_cast<int32_t>(m_regions.size());
+}
+
+RegionManager::~RegionManager() {
+}
+
+void RegionManager::SetMargins(float activeMargin, float freezeMargin) {
+    m_activeMargin = activeMargin;
+    // Histéresis: nunca congelar más cerca de lo que se activa
+    m_freezeMargin = std::max(activeMargin, freezeMargin);
+}
+
+void RegionManager::RegisterBody(b2Body* body) {
+    // El mismo punto que usa el traspaso en Update
+    int32_t index = RegionIndexAt(body->GetWorldCenter());
+    Region& region = m_regions[static_cast<size_t>(index)];
+    region.bodies.push_back(body);
+    m_bodyRegion[body] = index;
+
+    if (region.frozen && body->IsEnabled()) {
+        // Mismas condiciones que TryFreezeRegion
+        if (body->GetType() != b2_staticBody && (body->IsAwake() || !FreezesWithRegion(region, body))) {
+            ThawRegion(index);
+        } else if (FreezesWithRegion(region, body)) {
+            FreezeBody(region, body);
+        }
+    }
+}
+
+void RegionManager::UnregisterBody(b2Body* body) {
+    if (body == m_focusBody) {
+        m_focusBody = nullptr;
+    }
+
+    auto it = m_bodyRegion.find(body);
+    if (it == m_bodyRegion.end()) {
+        return;
+    }
+
+    Region& region = m_regions[static_cast<size_t>(it->second)];
+    auto bodyIt = std::find(region.bodies.begin(), region.bodies.end(), body);
+    if (bodyIt != region.bodies.end()) {
+        *bodyIt = region.bodies.back();
+        region.bodies.pop_back();
+    }
+
+    auto frozenIt = std::find(region.frozenBodies.begin(), region.frozenBodies.end(), body);
+    if (frozenIt != region.frozenBodies.end()) {
+        *frozenIt = region.frozenBodies.back();
+        region.frozenBodies.pop_back();
+        int32_t fixtures = CountFixtures(body);
+        region.frozenFixtures -= fixtures;
+        m_stats.frozenFixtures -= fixtures;
+        --m_stats.frozenBodies;
+    }
+
+    m_bodyRegion.erase(it);
+}
+
+void RegionManager::SetFocusArea(const b2AABB& area) {
+    m_focusArea = area;
+    m_hasFocusArea = true;
+
+    b2AABB expanded = area;
+    expanded.lowerBound -= b2Vec2(m_activeMargin, m_activeMargin);
+    expanded.upperBound += b2Vec2(m_activeMargin, m_activeMargin);
+    ThawRegionsOverlapping(expanded);
+}
+
+void RegionManager::Update(float deltaTime) {
+    ++m_tick;
+    m_stats.handoffsLastUpdate = 0;
+
+    // 1. Lo que está en foco se simula siempre
+    if (m_hasFocusArea) {
+        b2AABB area = m_focusArea;
+        area.lowerBound -= b2Vec2(m_activeMargin, m_activeMargin);
+        area.upperBound += b2Vec2(m_activeMargin, m_activeMargin);
+        ThawRegionsOverlapping(area);
+    }
+    b2AABB focusBodyAABB;
+    if (m_focusBody && ComputeBodyAABB(m_focusBody, focusBodyAABB)) {
+        focusBodyAABB.lowerBound -= b2Vec2(m_activeMargin, m_activeMargin);
+        focusBodyAABB.upperBound += b2Vec2(m_activeMargin, m_activeMargin);
+        ThawRegionsOverlapping(focusBodyAABB);
+    }
+
+    // 2. Traspaso de cuerpos despiertos entre regiones. Solo se recorren las
+    //    regiones activas: las congeladas no pueden tener cuerpos en movimiento.
+    for (size_t k = 0; k < m_activeRegions.size(); ++k) {
+        int32_t regionIndex = m_activeRegions[k];
+
+        size_t i = 0;
+        while (i < m_regions[static_cast<size_t>(regionIndex)].bodies.size()) {
+            b2Body* body = m_regions[static_cast<size_t>(regionIndex)].bodies[i];
+            if (body->GetType() == b2_staticBody || !body->IsAwake() || !body->IsEnabled()) {
+                ++i;
+                continue;
+            }
+
+            // Descongelar lo que el cuerpo puede tocar durante el próximo Step
+            b2AABB swept;
+            if (ComputeBodyAABB(body, swept)) {
+                b2Vec2 d = deltaTime * body->GetLinearVelocity();
+                swept.lowerBound += b2Min(d, b2Vec2_zero);
+                swept.upperBound += b2Max(d, b2Vec2_zero);
+                ThawRegionsOverlapping(swept);
+            }
+
+            int32_t target = RegionIndexAt(body->GetWorldCenter());
+            if (target != regionIndex) {
+                MoveBody(body, regionIndex, target);
+                ++m_stats.handoffsLastUpdate;
+                continue; // MoveBody dejó otro cuerpo en la posición i
+            }
+            ++i;
+        }
+    }
+
+    // 3. Congelar regiones fuera de foco, a menor frecuencia
+    if (m_tick % m_freezeCheckInterval == 0) {
+        size_t k = 0;
+        while (k < m_activeRegions.size()) {
+            int32_t regionIndex = m_activeRegions[k];
+            const Region& region = m_regions[static_cast<size_t>(regionIndex)];
+            if (!OverlapsFocus(region, m_freezeMargin) && TryFreezeRegion(regionIndex)) {
+                m_activeRegions[k] = m_activeRegions.back();
+                m_activeRegions.pop_back();
+                continue;
+            }
+            ++k;
+        }
+    }
+
+    m_stats.activeRegions = static_cast<int32_t>(m_activeRegions.size());
+    m_stats.frozenRegions = m_stats.totalRegions - m_stats.activeRegions;
+}
+
+void RegionManager::ThawAll() {
+    for (int32_t i = 0; i < static_cast<int32_t>(m_regions.size()); ++i) {
+        ThawRegion(i);
+    }
+}
+
+int32_t RegionManager::RegionIndexAt(const b2Vec2& p) const {
+    int32_t x = static_cast<int32_t>(std::floor((p.x - m_bounds.lowerBound.x) / m_regionSize));
+    int32_t y = static_cast<int32_t>(std::floor((p.y - m_bounds.lowerBound.y) / m_regionSize));
+    x = b2Clamp(x, 0, m_columns - 1);
+    y = b2Clamp(y, 0, m_rows - 1);
+    return y * m_columns + x;
+}
+
+void RegionManager::CellRange(const b2AABB& aabb, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) const {
+    x0 = static_cast<int32_t>(std::floor((aabb.lowerBound.x - m_bounds.lowerBound.x) / m_regionSize));
+    y0 = static_cast<int32_t>(std::floor((aabb.lowerBound.y - m_bounds.lowerBound.y) / m_regionSize));
+    x1 = static_cast<int32_t>(std::floor((aabb.upperBound.x - m_bounds.lowerBound.x) / m_regionSize));
+    y1 = static_cast<int32_t>(std::floor((aabb.upperBound.y - m_bounds.lowerBound.y) / m_regionSize));
+    x0 = b2Clamp(x0, 0, m_columns - 1);
+    y0 = b2Clamp(y0, 0, m_rows - 1);
+    x1 = b2Clamp(x1, 0, m_columns - 1);
+    y1 = b2Clamp(y1, 0, m_rows - 1);
+}
+
+bool RegionManager::OverlapsFocus(const Region& region, float margin) const {
+    b2AABB bounds = region.bounds;
+    bounds.lowerBound -= b2Vec2(margin, margin);
+    bounds.upperBound += b2Vec2(margin, margin);
+
+    if (m_hasFocusArea && b2TestOverlap(bounds, m_focusArea)) {
+        return true;
+    }
+    b2AABB focusBodyAABB;
+    if (m_focusBody && ComputeBodyAABB(m_focusBody, focusBodyAABB) && b2TestOverlap(bounds, focusBodyAABB)) {
+        return true;
+    }
+    return false;
+}
+
+bool RegionManager::ComputeBodyAABB(b2Body* body, b2AABB& aabb) {
+    bool hasFixture = false;
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        int32 childCount = fixture->GetShape()->GetChildCount();
+        for (int32 child = 0; child < childCount; ++child) {
+            b2AABB childAABB;
+            fixture->GetShape()->ComputeAABB(&childAABB, body->GetTransform(), child);
+            if (hasFixture) {
+                aabb.Combine(childAABB);
+            } else {
+                aabb = childAABB;
+                hasFixture = true;
+            }
+        }
+    }
+    return hasFixture;
+}
+
+int32_t RegionManager::CountFixtures(b2Body* body) {
+    int32_t count = 0;
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        ++count;
+    }
+    return count;
+}
+
+void RegionManager::FreezeBody(Region& region, b2Body* body) {
+    body->SetEnabled(false);
+    region.frozenBodies.push_back(body);
+    int32_t fixtures = CountFixtures(body);
+    region.frozenFixtures += fixtures;
+    m_stats.frozenFixtures += fixtures;
+    ++m_stats.frozenBodies;
+}
+
+void RegionManager::ThawRegion(int32_t index) {
+    Region& region = m_regions[static_cast<size_t>(index)];
+    if (!region.frozen) {
+        return;
+    }
+
+    for (b2Body* body : region.frozenBodies) {
+        body->SetEnabled(true);
+    }
+    m_stats.frozenBodies -= static_cast<int32_t>(region.frozenBodies.size());
+    m_stats.frozenFixtures -= region.frozenFixtures;
+    region.frozenBodies.clear();
+    region.frozenFixtures = 0;
+    region.frozen = false;
+    m_activeRegions.push_back(index);
+}
+
+void RegionManager::ThawRegionsOverlapping(const b2AABB& aabb) {
+    int32_t x0, y0, x1, y1;
+    CellRange(aabb, x0, y0, x1, y1);
+    for (int32_t y = y0; y <= y1; ++y) {
+        for (int32_t x = x0; x <= x1; ++x) {
+            ThawRegion(y * m_columns + x);
+        }
+    }
+}
+
+bool RegionManager::FreezesWithRegion(const Region& region, b2Body* body) {
+    if (!body->IsEnabled()) {
+        return false; // Deshabilitado por el juego, no es nuestro
+    }
+
+    // Cuerpos que sobresalen de la región (suelo, muros) siguen habilitados:
+    // las regiones vecinas activas pueden estar apoyadas en ellos. Solo pasa
+    // con estáticos; uno dinámico que sobresale impide congelar la región.
+    b2AABB aabb;
+    return !ComputeBodyAABB(body, aabb) || region.bounds.Contains(aabb);
+}
+
+bool RegionManager::TryFreezeRegion(int32_t index) {
+    Region& region = m_regions[static_cast<size_t>(index)];
+
+    // Mientras algo se mueva en la región (p.ej. una estructura derrumbándose),
+    // se sigue simulando aunque esté fuera de cámara. Tampoco se congela con un
+    // cuerpo no estático que sobresale: seguiría habilitado y, al despertar,
+    // Update no lo vería porque solo recorre las regiones activas.
+    for (b2Body* body : region.bodies) {
+        if (body->GetType() == b2_staticBody || !body->IsEnabled()) {
+            continue;
+        }
+        if (body->IsAwake() || !FreezesWithRegion(region, body)) {
+            return false;
+        }
+    }
+
+    // Tampoco si algo de otra región se apoya en lo que se congela (una torre
+    // a caballo de dos regiones): al deshabilitarlo se caería. Los cuerpos
+    // estáticos no se mueven, así que no cuentan.
+    for (b2Body* body : region.bodies) {
+        if (!FreezesWithRegion(region, body)) {
+            continue;
+        }
+        for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next) {
+            b2Body* other = edge->other;
+            if (!edge->contact->IsTouching() || other->GetType() == b2_staticBody) {
+                continue;
+            }
+            auto it = m_bodyRegion.find(other);
+            bool freezesToo = it != m_bodyRegion.end() && it->second == index && FreezesWithRegion(region, other);
+            if (!freezesToo) {
+                return false;
+            }
+        }
+    }
+
+    for (b2Body* body : region.bodies) {
+        if (FreezesWithRegion(region, body)) {
+            FreezeBody(region, body);
+        }
+    }
+
+    region.frozen = true;
+    return true;
+}
+
+void RegionManager::MoveBody(b2Body* body, int32_t from, int32_t to) {
+    Region& source = m_regions[static_cast<size_t>(from)];
+    auto it = std::find(source.bodies.begin(), source.bodies.end(), body);
+    if (it != source.bodies.end()) {
+        *it = source.bodies.back();
+        source.bodies.pop_back();
+    }
+
+    ThawRegion(to);
+    m_regions[static_cast<size_t>(to)].bodies.push_back(body);
+    m_bodyRegion[body] = to;
+}
@@ -0,0 +1,101 @@
+//
+// Particiona el mundo en regiones para no simular lo que está lejos.
+//
+#ifndef REGIONMANAGER_H
+#define REGIONMANAGER_H
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct RegionStats {
+    int32_t totalRegions = 0;
+    int32_t activeRegions = 0;
+    int32_t frozenRegions = 0;
+    int32_t frozenBodies = 0;
+    int32_t frozenFixtures = 0;     // Fuera del broadphase mientras están congelados
+    int32_t handoffsLastUpdate = 0; // Cuerpos que cambiaron de región en el último Update
+};
+
+// Rejilla uniforme de regiones sobre un b2World.
+//
+// Box2D integra todo el b2World con un único dt, así que una región no puede
+// avanzar a otra frecuencia sin partir el mundo (y perder los contactos entre
+// regiones). En su lugar, una región lejana y en reposo se congela: sus cuerpos
+// se deshabilitan (SetEnabled(false)), salen del broadphase y del solver y no
+// cuestan nada. Las regiones activas se simulan normalmente; las que están
+// fuera de foco solo se revisan cada m_freezeCheckInterval ticks.
+//
+// Una región se descongela cuando entra en el foco (cámara / pájaro) o cuando
+// el AABB barrido de un cuerpo despierto la toca, de modo que lo que cruza una
+// frontera encuentra el mundo habilitado antes del siguiente Step.
+class RegionManager {
+public:
+    RegionManager(b2World* world, const b2AABB& bounds, float regionSize);
+    ~RegionManager();
+
+    void RegisterBody(b2Body* body);
+    void UnregisterBody(b2Body* body);
+
+    // Descongela el área en el acto, sin esperar al próximo Update
+    void SetFocusArea(const b2AABB& area);
+    void SetFocusBody(b2Body* body) { m_focusBody = body; }
+    void SetMargins(float activeMargin, float freezeMargin);
+    void SetFreezeCheckInterval(int32_t ticks) { m_freezeCheckInterval = ticks > 0 ? ticks : 1; }
+
+    // Se llama antes de cada b2World::Step
+    void Update(float deltaTime);
+
+    // Habilita todos los cuerpos congelados (p.ej. antes de desactivar regiones)
+    void ThawAll();
+    // Habilita las regiones que toca aabb (p.ej. el área de una explosión)
+    void ThawRegionsOverlapping(const b2AABB& aabb);
+
+    const RegionStats& GetStats() const { return m_stats; }
+
+private:
+    struct Region {
+        std::vector<b2Body*> bodies;
+        std::vector<b2Body*> frozenBodies; // Los que deshabilitó el congelado
+        int32_t frozenFixtures = 0;
+        b2AABB bounds;
+        bool frozen = false;
+    };
+
+    int32_t RegionIndexAt(const b2Vec2& p) const;
+    void CellRange(const b2AABB& aabb, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) const;
+    bool OverlapsFocus(const Region& region, float margin) const;
+    static bool ComputeBodyAABB(b2Body* body, b2AABB& aabb);
+    static int32_t CountFixtures(b2Body* body);
+
+    // Lo que deshabilitaría congelar region
+    static bool FreezesWithRegion(const Region& region, b2Body* body);
+    void FreezeBody(Region& region, b2Body* body);
+    void ThawRegion(int32_t index);
+    bool TryFreezeRegion(int32_t index);
+    void MoveBody(b2Body* body, int32_t from, int32_t to);
+
+    b2World* m_world;
+    b2AABB m_bounds;
+    float m_regionSize;
+    int32_t m_columns;
+    int32_t m_rows;
+
+    std::vector<Region> m_regions;
+    std::vector<int32_t> m_activeRegions;
+    std::unordered_map<b2Body*, int32_t> m_bodyRegion;
+
+    b2AABB m_focusArea;
+    bool m_hasFocusArea;
+    b2Body* m_focusBody;
+    float m_activeMargin;
+    float m_freezeMargin;
+
+    int32_t m_freezeCheckInterval;
+    int32_t m_tick;
+
+    RegionStats m_stats;
+};
+
+#endif //REGIONMANAGER_H
@@ -0,0 +1,205 @@
+#include "StateReader.h"
+#include <algorithm>
+#include <iostream>
+
+bool StateReader::Open(const std::string& path) {
+    Close();
+
+    m_file.open(path, std::ios::binary);
+    if (!m_file) {
+        std::cerr << "[StateReader] No se pudo abrir " << path << std::endl;
+        return false;
+    }
+
+    m_file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(m_file.tellg());
+    m_file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> bytes(RecordingFormat::kHeaderSize);
+    if (fileSize < bytes.size() || !m_file.read(reinterpret_cast<char*>(bytes.data()), bytes.size()) ||
+        !std::equal(RecordingFormat::kMagic, RecordingFormat::kMagic + 4, bytes.begin())) {
+        std::cerr << "[StateReader] " << path << " no es una grabación válida" << std::endl;
+        Close();
+        return false;
+    }
+
+    const uint8_t* p = bytes.data() + 4;
+    const uint8_t* end = bytes.data() + bytes.size();
+    RecordingFormat::Get(p, end, m_header.version);
+    RecordingFormat::Get(p, end, m_header.keyframeInterval);
+    RecordingFormat::Get(p, end, m_header.positionQuantum);
+    RecordingFormat::Get(p, end, m_header.angleQuantum);
+    RecordingFormat::Get(p, end, m_header.velocityQuantum);
+
+    if (m_header.version != RecordingFormat::kVersion || m_header.keyframeInterval == 0) {
+        std::cerr << "[StateReader] Versión de grabación no soportada: " << m_header.version << std::endl;
+        Close();
+        return false;
+    }
+
+    if (!LoadIndex(fileSize)) {
+        ScanFrames(fileSize);
+    }
+    return true;
+}
+
+void StateReader::Close() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_file.clear();
+    m_header = RecordingFormat::Header();
+    m_frameOffsets.clear();
+    m_current = kNoFrame;
+    m_bodyCount = 0;
+    m_quantized.clear();
+    m_present.clear();
+}
+
+bool StateReader::LoadIndex(uint64_t fileSize) {
+    if (fileSize < RecordingFormat::kHeaderSize + RecordingFormat::kFooterSize) {
+        return false;
+    }
+
+    std::vector<uint8_t> footer(RecordingFormat::kFooterSize);
+    m_file.seekg(static_cast<std::streamoff>(fileSize - footer.size()));
+    if (!m_file.read(reinterpret_cast<char*>(footer.data()), footer.size()) ||
+        !std::equal(RecordingFormat::kIndexMagic, RecordingFormat::kIndexMagic + 4, footer.end() - 4)) {
+        m_file.clear();
+        return false;
+    }
+
+    uint64_t indexOffset = 0;
+    uint64_t frameCount = 0;
+    const uint8_t* p = footer.data();
+    RecordingFormat::Get(p, footer.data() + footer.size(), indexOffset);
+    RecordingFormat::Get(p, footer.data() + footer.size(), frameCount);
+    if (indexOffset + frameCount * sizeof(uint64_t) + footer.size() != fileSize) {
+        return false;
+    }
+
+    m_frameOffsets.resize(frameCount);
+    m_file.seekg(static_cast<std::streamoff>(indexOffset));
+    if (frameCount > 0 && !m_file.read(reinterpret_cast<char*>(m_frameOffsets.data()), frameCount * sizeof(uint64_t))) {
+        m_file.clear();
+        m_frameOffsets.clear();
+        return false;
+    }
+    return true;
+}
+
+void StateReader::ScanFrames(uint64_t fileSize) {
+    // Sin índice: saltar de frame en frame por el tamaño del payload. Un
+    // frame truncado al final (grabación interrumpida) se descarta.
+    m_frameOffsets.clear();
+    uint64_t offset = RecordingFormat::kHeaderSize;
+    while (offset + sizeof(uint32_t) <= fileSize) {
+        uint32_t payloadSize = 0;
+        m_file.seekg(static_cast<std::streamoff>(offset));
+        if (!m_file.read(reinterpret_cast<char*>(&payloadSize), sizeof(payloadSize)) ||
+            offset + sizeof(uint32_t) + payloadSize > fileSize) {
+            break;
+        }
+        m_frameOffsets.push_back(offset);
+        offset += sizeof(uint32_t) + payloadSize;
+    }
+    m_file.clear();
+}
+
+bool StateReader::ReadFrame(size_t index, RecordedFrame& frame) {
+    if (!m_file.is_open() || index >= m_frameOffsets.size()) {
+        return false;
+    }
+
+    if (m_current == kNoFrame || index < m_current || index - m_current > m_header.keyframeInterval) {
+        // Salto: decodificar desde el keyframe anterior
+        size_t keyframe = index - index % m_header.keyframeInterval;
+        for (size_t i = keyframe; i < index; ++i) {
+            if (!DecodeFrame(i)) {
+                return false;
+            }
+        }
+    } else {
+        for (size_t i = m_current + 1; i < index; ++i) {
+            if (!DecodeFrame(i)) {
+                return false;
+            }
+        }
+    }
+    if (index != m_current && !DecodeFrame(index)) {
+        return false;
+    }
+
+    frame.step = m_step;
+    frame.time = m_time;
+    frame.keyframe = m_keyframe;
+    frame.states.resize(m_bodyCount);
+    frame.present.assign(m_present.begin(), m_present.begin() + m_bodyCount);
+    for (uint32_t i = 0; i < m_bodyCount; ++i) {
+        frame.states[i] = m_present[i]
+            ? RecordingFormat::Dequantize(&m_quantized[static_cast<size_t>(i) * RecordingFormat::kComponents], m_header)
+            : BodyState();
+    }
+    return true;
+}
+
+bool StateReader::DecodeFrame(size_t index) {
+    m_current = kNoFrame;
+
+    uint32_t payloadSize = 0;
+    m_file.seekg(static_cast<std::streamoff>(m_frameOffsets[index]));
+    if (!m_file.read(reinterpret_cast<char*>(&payloadSize), sizeof(payloadSize))) {
+        m_file.clear();
+        return false;
+    }
+    m_payload.resize(payloadSize);
+    if (!m_file.read(reinterpret_cast<char*>(m_payload.data()), payloadSize)) {
+        m_file.clear();
+        return false;
+    }
+
+    const uint8_t* p = m_payload.data();
+    const uint8_t* end = p + m_payload.size();
+    uint8_t flags = 0;
+    uint32_t bodyCount = 0;
+    if (!RecordingFormat::Get(p, end, flags) || !RecordingFormat::Get(p, end, m_step) ||
+        !RecordingFormat::Get(p, end, m_time) || !RecordingFormat::Get(p, end, bodyCount)) {
+        return false;
+    }
+    m_keyframe = (flags & RecordingFormat::kKeyframeFlag) != 0;
+
+    const size_t maskSize = (bodyCount + 7) / 8;
+    if (static_cast<size_t>(end - p) < maskSize) {
+        return false;
+    }
+    const uint8_t* mask = p;
+    p += maskSize;
+
+    // Los ids solo crecen; un keyframe vuelve a la base cero
+    if (bodyCount > m_bodyCount) {
+        m_quantized.resize(static_cast<size_t>(bodyCount) * RecordingFormat::kComponents, 0);
+        m_present.resize(bodyCount, 0);
+    }
+    if (m_keyframe) {
+        std::fill(m_quantized.begin(), m_quantized.end(), 0);
+    }
+    m_bodyCount = bodyCount;
+
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        m_present[i] = (mask[i / 8] >> (i % 8)) & 1;
+        if (!m_present[i]) {
+            continue;
+        }
+        int32_t* quantized = &m_quantized[static_cast<size_t>(i) * RecordingFormat::kComponents];
+        for (int c = 0; c < RecordingFormat::kComponents; ++c) {
+            uint32_t delta;
+            if (!RecordingFormat::GetVarint(p, end, delta)) {
+                return false;
+            }
+            quantized[c] += RecordingFormat::UnZigZag(delta);
+        }
+    }
+
+    m_current = index;
+    return true;
+}
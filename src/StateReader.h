@@ -0,0 +1,57 @@
+//
+// Lectura con acceso aleatorio de archivos grabados por StateRecorder.
+//
+#ifndef STATEREADER_H
+#define STATEREADER_H
+
+#include "RecordingFormat.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct RecordedFrame {
+    uint64_t step = 0;
+    float time = 0.0f;
+    bool keyframe = false;
+    std::vector<BodyState> states; // Indexado por id de cuerpo
+    std::vector<uint8_t> present;  // 1 si el cuerpo existía en este paso
+};
+
+// Leer frames consecutivos hacia delante decodifica solo el delta; un salto
+// busca el keyframe anterior en el índice y decodifica desde ahí (como mucho
+// keyframeInterval frames). Si el archivo no tiene índice (la grabación no se
+// cerró) se reconstruye recorriendo los frames.
+class StateReader {
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_file.is_open(); }
+
+    const RecordingFormat::Header& GetHeader() const { return m_header; }
+    size_t GetFrameCount() const { return m_frameOffsets.size(); }
+
+    bool ReadFrame(size_t index, RecordedFrame& frame);
+
+private:
+    bool LoadIndex(uint64_t fileSize);
+    void ScanFrames(uint64_t fileSize);
+    bool DecodeFrame(size_t index);
+
+    std::ifstream m_file;
+    RecordingFormat::Header m_header;
+    std::vector<uint64_t> m_frameOffsets;
+
+    // Último frame decodificado, cuantizado, base del siguiente delta
+    static const size_t kNoFrame = static_cast<size_t>(-1);
+    size_t m_current = kNoFrame;
+    uint64_t m_step = 0;
+    float m_time = 0.0f;
+    bool m_keyframe = false;
+    uint32_t m_bodyCount = 0;
+    std::vector<int32_t> m_quantized;
+    std::vector<uint8_t> m_present;
+    std::vector<uint8_t> m_payload;
+};
+
+#endif //STATEREADER_H
@@ -0,0 +1,242 @@
+#include "StateRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    size_t NextPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+StateRecorder::~StateRecorder() {
+    Stop();
+}
+
+bool StateRecorder::Start(const std::string& path, const RecorderConfig& config) {
+    Stop();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        std::cerr << "[StateRecorder] No se pudo abrir " << path << std::endl;
+        return false;
+    }
+
+    m_config = config;
+    m_config.maxBodies = std::max<uint32_t>(m_config.maxBodies, 1);
+    m_config.keyframeInterval = std::max<uint32_t>(m_config.keyframeInterval, 1);
+
+    m_header = RecordingFormat::Header();
+    m_header.keyframeInterval = m_config.keyframeInterval;
+    m_header.positionQuantum = m_config.positionQuantum;
+    m_header.angleQuantum = m_config.angleQuantum;
+    m_header.velocityQuantum = m_config.velocityQuantum;
+
+    // Toda la memoria del anillo se reserva aquí; Capture no asigna
+    const size_t ringFrames = NextPowerOfTwo(std::max<uint32_t>(m_config.ringFrames, 2));
+    m_ringMask = ringFrames - 1;
+    m_slots.assign(ringFrames, Slot());
+    m_ringStates.assign(ringFrames * m_config.maxBodies, BodyState());
+    m_ringPresent.assign(ringFrames * m_config.maxBodies, 0);
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_stopping.store(false, std::memory_order_relaxed);
+
+    m_bodies.clear();
+    m_ids.clear();
+    m_step = 0;
+    m_time = 0.0f;
+
+    m_previous.assign(static_cast<size_t>(m_config.maxBodies) * RecordingFormat::kComponents, 0);
+    m_frameOffsets.clear();
+    m_framesCaptured = 0;
+    m_framesDropped = 0;
+    m_framesWritten = 0;
+    m_bytesWritten = 0;
+
+    m_buffer.clear();
+    m_buffer.insert(m_buffer.end(), RecordingFormat::kMagic, RecordingFormat::kMagic + 4);
+    RecordingFormat::Put(m_buffer, m_header.version);
+    RecordingFormat::Put(m_buffer, m_header.keyframeInterval);
+    RecordingFormat::Put(m_buffer, m_header.positionQuantum);
+    RecordingFormat::Put(m_buffer, m_header.angleQuantum);
+    RecordingFormat::Put(m_buffer, m_header.velocityQuantum);
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+    m_fileOffset = m_buffer.size();
+    m_bytesWritten = m_buffer.size();
+
+    m_recording = true;
+    m_writer = std::thread(&StateRecorder::WriterLoop, this);
+    return true;
+}
+
+void StateRecorder::Stop() {
+    if (!m_recording) {
+        return;
+    }
+
+    m_stopping.store(true, std::memory_order_release);
+    m_writer.join();
+    m_recording = false;
+
+    // Índice de frames para acceso aleatorio
+    m_buffer.clear();
+    for (uint64_t offset : m_frameOffsets) {
+        RecordingFormat::Put(m_buffer, offset);
+    }
+    RecordingFormat::Put(m_buffer, m_fileOffset);
+    RecordingFormat::Put(m_buffer, static_cast<uint64_t>(m_frameOffsets.size()));
+    m_buffer.insert(m_buffer.end(), RecordingFormat::kIndexMagic, RecordingFormat::kIndexMagic + 4);
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+    m_bytesWritten += m_buffer.size();
+
+    m_file.close();
+}
+
+void StateRecorder::RegisterBody(b2Body* body) {
+    if (!m_recording || m_ids.count(body)) {
+        return;
+    }
+    if (m_bodies.size() >= m_config.maxBodies) {
+        std::cerr << "[StateRecorder] Límite de " << m_config.maxBodies << " cuerpos alcanzado" << std::endl;
+        return;
+    }
+    m_ids[body] = static_cast<uint32_t>(m_bodies.size());
+    m_bodies.push_back(body);
+}
+
+void StateRecorder::UnregisterBody(b2Body* body) {
+    auto it = m_ids.find(body);
+    if (it == m_ids.end()) {
+        return;
+    }
+    m_bodies[it->second] = nullptr;
+    m_ids.erase(it);
+}
+
+void StateRecorder::Capture(float deltaTime) {
+    if (!m_recording) {
+        return;
+    }
+
+    ++m_step;
+    m_time += deltaTime;
+    m_framesCaptured.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_ringMask) {
+        m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const size_t index = head & m_ringMask;
+    Slot& slot = m_slots[index];
+    slot.step = m_step;
+    slot.time = m_time;
+    slot.bodyCount = static_cast<uint32_t>(m_bodies.size());
+
+    BodyState* states = &m_ringStates[index * m_config.maxBodies];
+    uint8_t* present = &m_ringPresent[index * m_config.maxBodies];
+    for (uint32_t i = 0; i < slot.bodyCount; ++i) {
+        const b2Body* body = m_bodies[i];
+        present[i] = body != nullptr;
+        if (body) {
+            const b2Vec2& position = body->GetPosition();
+            const b2Vec2& velocity = body->GetLinearVelocity();
+            BodyState& state = states[i];
+            state.x = position.x;
+            state.y = position.y;
+            state.angle = body->GetAngle();
+            state.vx = velocity.x;
+            state.vy = velocity.y;
+            state.angularVelocity = body->GetAngularVelocity();
+        }
+    }
+
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+RecorderStats StateRecorder::GetStats() const {
+    RecorderStats stats;
+    stats.framesCaptured = m_framesCaptured.load(std::memory_order_relaxed);
+    stats.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    stats.framesWritten = m_framesWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void StateRecorder::WriterLoop() {
+    while (true) {
+        // Leer m_stopping antes que m_head: si ya se pidió parar, m_head
+        // incluye todos los frames capturados
+        const bool stopping = m_stopping.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+
+        if (tail == head) {
+            if (stopping) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        const size_t index = tail & m_ringMask;
+        EncodeFrame(m_slots[index], &m_ringStates[index * m_config.maxBodies],
+                    &m_ringPresent[index * m_config.maxBodies]);
+        m_tail.store(tail + 1, std::memory_order_release);
+    }
+
+    m_file.flush();
+}
+
+void StateRecorder::EncodeFrame(const Slot& slot, const BodyState* states, const uint8_t* present) {
+    // Un keyframe se codifica respecto a cero para poder empezar a leer en él
+    const bool keyframe = m_frameOffsets.size() % m_header.keyframeInterval == 0;
+    if (keyframe) {
+        std::fill(m_previous.begin(), m_previous.end(), 0);
+    }
+
+    m_buffer.clear();
+    RecordingFormat::Put(m_buffer, uint32_t(0)); // Tamaño del payload, se rellena al final
+    RecordingFormat::Put(m_buffer, keyframe ? RecordingFormat::kKeyframeFlag : uint8_t(0));
+    RecordingFormat::Put(m_buffer, slot.step);
+    RecordingFormat::Put(m_buffer, slot.time);
+    RecordingFormat::Put(m_buffer, slot.bodyCount);
+
+    const size_t maskStart = m_buffer.size();
+    m_buffer.resize(maskStart + (slot.bodyCount + 7) / 8, 0);
+    for (uint32_t i = 0; i < slot.bodyCount; ++i) {
+        if (present[i]) {
+            m_buffer[maskStart + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+    }
+
+    for (uint32_t i = 0; i < slot.bodyCount; ++i) {
+        if (!present[i]) {
+            continue;
+        }
+        int32_t quantized[RecordingFormat::kComponents];
+        RecordingFormat::Quantize(states[i], m_header, quantized);
+
+        int32_t* previous = &m_previous[static_cast<size_t>(i) * RecordingFormat::kComponents];
+        for (int c = 0; c < RecordingFormat::kComponents; ++c) {
+            RecordingFormat::PutVarint(m_buffer, RecordingFormat::ZigZag(quantized[c] - previous[c]));
+            previous[c] = quantized[c];
+        }
+    }
+
+    const uint32_t payloadSize = static_cast<uint32_t>(m_buffer.size() - sizeof(uint32_t));
+    std::memcpy(m_buffer.data(), &payloadSize, sizeof(payloadSize));
+
+    m_frameOffsets.push_back(m_fileOffset);
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+    m_fileOffset += m_buffer.size();
+
+    m_framesWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(m_buffer.size(), std::memory_order_relaxed);
+}
@@ -0,0 +1,104 @@
+//
+// Graba el estado de todos los cuerpos en cada paso sin frenar el Step.
+//
+#ifndef STATERECORDER_H
+#define STATERECORDER_H
+
+#include <box2d/box2d.h>
+#include "RecordingFormat.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct RecorderConfig {
+    uint32_t maxBodies = 4096;      // Ids disponibles; no se reutilizan
+    uint32_t ringFrames = 64;       // Frames en vuelo hacia el hilo escritor (se redondea a potencia de 2)
+    uint32_t keyframeInterval = 60; // Frames entre keyframes (puntos de acceso aleatorio)
+    float positionQuantum = 1.0f / 1024.0f;
+    float angleQuantum = 1.0f / 4096.0f;
+    float velocityQuantum = 1.0f / 256.0f;
+};
+
+struct RecorderStats {
+    uint64_t framesCaptured = 0;
+    uint64_t framesDropped = 0; // Anillo lleno: el escritor no da abasto
+    uint64_t framesWritten = 0;
+    uint64_t bytesWritten = 0;
+};
+
+// El hilo del Step solo copia poses y velocidades a un anillo SPSC
+// preasignado; un hilo propio las cuantiza, codifica en deltas y escribe el
+// archivo (ver RecordingFormat.h). Si el anillo está lleno el frame se
+// descarta en lugar de bloquear el Step; el número de paso queda en el
+// archivo, así que los huecos se notan al reproducir.
+//
+// Cada cuerpo registrado recibe un id consecutivo que indexa los frames.
+class StateRecorder {
+public:
+    StateRecorder() = default;
+    ~StateRecorder();
+
+    StateRecorder(const StateRecorder&) = delete;
+    StateRecorder& operator=(const StateRecorder&) = delete;
+
+    bool Start(const std::string& path, const RecorderConfig& config = RecorderConfig());
+    // Vacía el anillo, escribe el índice y cierra el archivo
+    void Stop();
+    bool IsRecording() const { return m_recording; }
+
+    void RegisterBody(b2Body* body);
+    void UnregisterBody(b2Body* body);
+
+    // Llamar tras cada Step desde el mismo hilo
+    void Capture(float deltaTime);
+
+    RecorderStats GetStats() const;
+
+private:
+    struct Slot {
+        uint64_t step;
+        float time;
+        uint32_t bodyCount;
+    };
+
+    void WriterLoop();
+    void EncodeFrame(const Slot& slot, const BodyState* states, const uint8_t* present);
+
+    bool m_recording = false;
+    RecorderConfig m_config;
+    RecordingFormat::Header m_header;
+
+    // Registro de cuerpos (hilo del Step)
+    std::vector<b2Body*> m_bodies; // nullptr si el cuerpo se destruyó
+    std::unordered_map<b2Body*, uint32_t> m_ids;
+    uint64_t m_step = 0;
+    float m_time = 0.0f;
+
+    // Anillo SPSC: m_head lo avanza el Step, m_tail el escritor
+    std::vector<Slot> m_slots;
+    std::vector<BodyState> m_ringStates; // ringFrames * maxBodies
+    std::vector<uint8_t> m_ringPresent;
+    size_t m_ringMask = 0;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+    std::atomic<bool> m_stopping{false};
+
+    // Estado del escritor
+    std::thread m_writer;
+    std::ofstream m_file;
+    std::vector<int32_t> m_previous; // Último frame escrito, cuantizado
+    std::vector<uint8_t> m_buffer;
+    std::vector<uint64_t> m_frameOffsets;
+    uint64_t m_fileOffset = 0;
+
+    std::atomic<uint64_t> m_framesCaptured{0};
+    std::atomic<uint64_t> m_framesDropped{0};
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+};
+
+#endif //STATERECORDER_H
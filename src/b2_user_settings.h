@@ -0,0 +1,50 @@
+//
+// Ajustes de usuario para Box2D 2.4 (B2_USER_SETTINGS).
+// Replica los valores por defecto de b2_settings.h, pero envía b2Alloc/b2Free
+// a MemoryTracker para contar la memoria del block allocator de Box2D.
+// Box2D y este proyecto deben compilarse con el mismo -DB2_USER_SETTINGS.
+//
+#ifndef B2_USER_SETTINGS_H
+#define B2_USER_SETTINGS_H
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "MemoryTracker.h"
+
+#define b2_lengthUnitsPerMeter 1.0f
+#define b2_maxPolygonVertices 8
+
+struct B2_API b2BodyUserData {
+    b2BodyUserData() { pointer = 0; }
+    uintptr_t pointer;
+};
+
+struct B2_API b2FixtureUserData {
+    b2FixtureUserData() { pointer = 0; }
+    uintptr_t pointer;
+};
+
+struct B2_API b2JointUserData {
+    b2JointUserData() { pointer = 0; }
+    uintptr_t pointer;
+};
+
+inline void* b2Alloc(int32 size) {
+    return MemoryTracker::Box2DAlloc(size);
+}
+
+inline void b2Free(void* mem) {
+    MemoryTracker::Box2DFree(mem);
+}
+
+B2_API void b2Log_Default(const char* string, va_list args);
+
+inline void b2Log(const char* string, ...) {
+    va_list args;
+    va_start(args, string);
+    b2Log_Default(string, args);
+    va_end(args);
+}
+
+#endif //B2_USER_SETTINGS_H
@@ -1,14 +1,19 @@
 #include <SFML/Graphics.hpp>
 #include "PhysicsWrapper.h"
+#include "DebugDraw.h"
+#include "Level.h"
 #include <vector>
 #include <memory>
 #include <iostream>
-#include <cmath> // Para std::cos y std::sin
+#include <algorithm>
+#include <cmath> // Para std::hypot
+#include <string>
 
 // --- Constants ---
 const float SCREEN_WIDTH = 1280.f;
 const float SCREEN_HEIGHT = 720.f;
 const float SCALE = 30.f;
+const float REGION_SIZE = 8.f; // Lado de cada región de simulación, en metros
 
 b2Vec2 pixelsToMeters(const sf::Vector2f& pixels) {
     return b2Vec2(pixels.x / SCALE, pixels.y / SCALE);
@@ -27,11 +32,14 @@ public:
 
     Game()
         : m_window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "Angry Birds - Estructura con Hexágono"),
-          m_physics(b2Vec2(0.0f, 9.8f)),
+          m_physics(b2Vec2(0.0f, kLevelGravity)),
           m_gameState(PLAYING)
     {
         m_window.setFramerateLimit(60);
 
+        m_debugDraw.SetFlags(b2Draw::e_shapeBit | b2Draw::e_aabbBit | b2Draw::e_centerOfMassBit |
+                             PhysicsWrapper::e_contactInfoBit);
+
         if (!m_font.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
             if (!m_font.loadFromFile("C:/Windows/Fonts/Arial.ttf")) {
                 std::cerr << "Error: No se pudo cargar la fuente." << std::endl;
@@ -43,6 +51,16 @@ public:
         m_messageText.setFillColor(sf::Color::White);
         m_messageText.setStyle(sf::Text::Bold);
 
+        m_statsText.setFont(m_font);
+        m_statsText.setCharacterSize(14);
+        m_statsText.setFillColor(sf::Color::Black);
+        m_statsText.setPosition(10.f, 30.f);
+
+        // Un cuerpo destruido desde la cola de comandos sale también del nivel
+        m_physics.SetBodyDestroyedCallback([this](b2Body* body) {
+            ForgetLevelBody(m_level, body);
+        });
+
         createScene();
     }
 
@@ -58,19 +76,9 @@ public:
 
 private:
     void reset() {
-        for (auto& body : m_bodies) {
-            m_physics.DestroyBody(body);
-        }
-        m_bodies.clear();
-
-        m_physics.DestroyBody(m_groundBody);
-        m_physics.DestroyBody(m_leftWallBody);
-        m_physics.DestroyBody(m_rightWallBody);
-        m_physics.DestroyBody(m_ceilingBody);
-
-        m_birdBody = nullptr;
-        m_pigBody = nullptr;
-        m_targetBody = nullptr;
+        DestroyLevel(m_physics, m_level);
+        m_physics.GetParticles().Clear();
+        m_physics.GetForceFields().Clear();
 
         m_isDragging = false;
         m_isBirdLaunched = false;
@@ -80,130 +88,14 @@ private:
     }
 
     void createScene() {
-        // --- Muros y suelo ---
-        b2BodyDef groundBodyDef;
-        groundBodyDef.position.Set(SCREEN_WIDTH / 2.f / SCALE, SCREEN_HEIGHT / SCALE - (10.f / SCALE));
-        m_groundBody = m_physics.CreateBody(&groundBodyDef);
-        b2PolygonShape groundBox;
-        groundBox.SetAsBox(SCREEN_WIDTH / 2.f / SCALE, 10.f / SCALE);
-        m_groundBody->CreateFixture(&groundBox, 0.0f);
-
-        // ... (código de los muros sin cambios)
-        b2BodyDef leftWallDef;
-        leftWallDef.position.Set(10.f / SCALE, SCREEN_HEIGHT / 2.f / SCALE);
-        m_leftWallBody = m_physics.CreateBody(&leftWallDef);
-        b2PolygonShape leftWallBox;
-        leftWallBox.SetAsBox(10.f / SCALE, SCREEN_HEIGHT / 2.f / SCALE);
-        m_leftWallBody->CreateFixture(&leftWallBox, 0.0f);
-
-        b2BodyDef rightWallDef;
-        rightWallDef.position.Set(SCREEN_WIDTH / SCALE - (10.f / SCALE), SCREEN_HEIGHT / 2.f / SCALE);
-        m_rightWallBody = m_physics.CreateBody(&rightWallDef);
-        b2PolygonShape rightWallBox;
-        rightWallBox.SetAsBox(10.f / SCALE, SCREEN_HEIGHT / 2.f / SCALE);
-        m_rightWallBody->CreateFixture(&rightWallBox, 0.0f);
-
-        b2BodyDef ceilingDef;
-        ceilingDef.position.Set(SCREEN_WIDTH / 2.f / SCALE, 10.f / SCALE);
-        m_ceilingBody = m_physics.CreateBody(&ceilingDef);
-        b2PolygonShape ceilingBox;
-        ceilingBox.SetAsBox(SCREEN_WIDTH / 2.f / SCALE, 10.f / SCALE);
-        m_ceilingBody->CreateFixture(&ceilingBox, 0.0f);
-
-
-        // --- Estructura de Obstáculos ---
-        createBox(950.f + 1 * 55.f, SCREEN_HEIGHT - 35.f, 25.f, 25.f);
-        createBox(950.f + 2 * 55.f, SCREEN_HEIGHT - 35.f, 25.f, 25.f);
-        createBox(977.f + 1 * 55.f, SCREEN_HEIGHT - 85.f, 25.f, 25.f);
-        createBox(1032.f, SCREEN_HEIGHT - 135.f, 80.f, 10.f);
-        createTriangle({1032.f, SCREEN_HEIGHT - 185.f}, 35.f);
-
-        // Añadimos el nuevo hexágono a la estructura
-        createHexagon({950.f, SCREEN_HEIGHT - 60.f}, 30.f);
-
-        // --- Cerdo (Objetivo) ---
-        b2BodyDef pigBodyDef;
-        pigBodyDef.type = b2_dynamicBody;
-        pigBodyDef.position.Set(1032.f / SCALE, (SCREEN_HEIGHT - 105.f) / SCALE);
-        m_pigBody = m_physics.CreateBody(&pigBodyDef);
-        b2CircleShape pigShape;
-        pigShape.m_radius = 15.f / SCALE;
-        m_physics.CreateCircleFixture(m_pigBody, &pigShape, 0.5f);
-        m_bodies.push_back(m_pigBody);
-        m_pigBody->SetSleepingAllowed(true);
-        m_pigBody->SetAwake(false);
-        m_targetBody = m_pigBody; // El cerdo sigue siendo el objetivo
-
-        // --- Pájaro ---
-        b2BodyDef birdBodyDef;
-        birdBodyDef.type = b2_dynamicBody;
-        birdBodyDef.position.Set(150.f / SCALE, (SCREEN_HEIGHT - 100.f) / SCALE);
-        m_birdBody = m_physics.CreateBody(&birdBodyDef);
-        b2CircleShape circleShape;
-        circleShape.m_radius = 20.f / SCALE;
-        m_physics.CreateCircleFixture(m_birdBody, &circleShape, 2.0f);
-        m_bodies.push_back(m_birdBody);
-        m_birdBody->SetSleepingAllowed(true);
-        m_birdBody->SetAwake(false);
+        // El nivel vive en Level.cpp; la simulación sin ventana usa el mismo
+        m_level = BuildDefaultLevel(m_physics);
         m_isBirdLaunched = false;
-    }
-    
-    // --- NUEVA FUNCIÓN PARA CREAR HEXÁGONOS ---
-    b2Body* createHexagon(const sf::Vector2f& position, float radius) {
-        b2BodyDef bodyDef;
-        bodyDef.type = b2_dynamicBody;
-        bodyDef.position = pixelsToMeters(position);
-        b2Body* hexaBody = m_physics.CreateBody(&bodyDef);
-
-        b2PolygonShape hexagonShape;
-        b2Vec2 vertices[6];
-        float angle = 0.0f;
-        for (int i = 0; i < 6; i++) {
-            vertices[i].Set(
-                (radius / SCALE) * std::cos(angle),
-                (radius / SCALE) * std::sin(angle)
-            );
-            angle += 60.0f * b2_pi / 180.0f; // 60 grados en radianes
-        }
-        hexagonShape.Set(vertices, 6);
-
-        m_physics.CreatePolygonFixture(hexaBody, &hexagonShape, 1.2f); // Densidad media
-        m_bodies.push_back(hexaBody);
-
-        hexaBody->SetSleepingAllowed(true);
-        hexaBody->SetAwake(false);
 
-        return hexaBody;
-    }
-
-    b2Body* createTriangle(const sf::Vector2f& position, float size) {
-        b2BodyDef bodyDef;
-        bodyDef.type = b2_dynamicBody;
-        bodyDef.position = pixelsToMeters(position);
-        b2Body* triangleBody = m_physics.CreateBody(&bodyDef);
-        b2PolygonShape triangleShape;
-        b2Vec2 vertices[3];
-        vertices[0].Set(0.0f, -size / SCALE);
-        vertices[1].Set(size / SCALE, size / SCALE);
-        vertices[2].Set(-size / SCALE, size / SCALE);
-        triangleShape.Set(vertices, 3);
-        m_physics.CreatePolygonFixture(triangleBody, &triangleShape, 1.5f);
-        m_bodies.push_back(triangleBody);
-        triangleBody->SetSleepingAllowed(true);
-        triangleBody->SetAwake(false);
-        return triangleBody;
-    }
-
-    b2Body* createBox(float x, float y, float halfWidth, float halfHeight) {
-        b2BodyDef bodyDef;
-        bodyDef.type = b2_dynamicBody;
-        bodyDef.position.Set(x / SCALE, y / SCALE);
-        b2Body* boxBody = m_physics.CreateBody(&bodyDef);
-        m_physics.CreateBoxFixture(boxBody, halfWidth / SCALE, halfHeight / SCALE, 1.0f);
-        m_bodies.push_back(boxBody);
-        boxBody->SetSleepingAllowed(true);
-        boxBody->SetAwake(false);
-        return boxBody;
+        // Lo que queda fuera de cámara y en reposo se congela; el pájaro
+        // descongela a su paso lo que tiene por delante
+        m_physics.EnableRegions(GetLevelBounds(), REGION_SIZE);
+        m_physics.SetRegionFocusBody(m_level.bird);
     }
 
     void processEvents() {
@@ -220,11 +112,39 @@ private:
             reset();
         }
 
+        // Evento para grabar/dejar de grabar la simulación
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::G) {
+            if (m_physics.IsRecording()) {
+                m_physics.StopRecording();
+                RecorderStats stats = m_physics.GetRecorderStats();
+                std::cout << "Grabación terminada: " << stats.framesWritten << " frames, "
+                          << stats.bytesWritten << " bytes, " << stats.framesDropped << " descartados" << std::endl;
+            } else if (m_physics.StartRecording("recording.b2rec")) {
+                std::cout << "Grabando en recording.b2rec" << std::endl;
+            }
+        }
+
+        // Zoom de la cámara con la rueda
+        if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+            zoomCamera(event.mouseWheelScroll.delta > 0 ? 0.9f : 1.f / 0.9f);
+        }
+
+        // Evento para volver a centrar la cámara
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::C) {
+            m_camera = sf::View(sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, SCREEN_HEIGHT));
+        }
+
+        // Evento para mostrar/ocultar el dibujo de depuración
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::D) {
+            m_showDebugDraw = !m_showDebugDraw;
+            m_physics.SetDebugDraw(m_showDebugDraw ? &m_debugDraw : nullptr);
+        }
+
         if (m_gameState == PLAYING) {
             if (event.type == sf::Event::MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    sf::Vector2f mousePos = m_window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
-                    sf::Vector2f birdPos = metersToPixels(m_birdBody->GetPosition());
+                if (event.mouseButton.button == sf::Mouse::Left && m_level.bird) {
+                    sf::Vector2f mousePos = m_window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y}, m_camera);
+                    sf::Vector2f birdPos = metersToPixels(m_level.bird->GetPosition());
                     if (std::hypot(mousePos.x - birdPos.x, mousePos.y - birdPos.y) < 30.f && !m_isBirdLaunched) {
                         m_isDragging = true;
                         m_dragStartPos = mousePos;
@@ -232,25 +152,77 @@ private:
                 }
             }
 
+            // Clic derecho: explosión (como un bloque de TNT) en el cursor
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right) {
+                sf::Vector2f mousePos = m_window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y}, m_camera);
+                m_physics.GetForceFields().Add(ForceField::Explosion(pixelsToMeters(mousePos), 4.f, 30.f));
+            }
+
             if (event.type == sf::Event::MouseButtonReleased) {
                 if (event.mouseButton.button == sf::Mouse::Left && m_isDragging) {
                     m_isDragging = false;
                     m_isBirdLaunched = true;
-                    m_birdBody->SetAwake(true);
-                    sf::Vector2f dragEndPos = m_window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
-                    sf::Vector2f launchVector = m_dragStartPos - dragEndPos;
-                    float launchPower = 0.5f;
-                    m_birdBody->SetLinearVelocity(b2Vec2(launchVector.x * launchPower, launchVector.y * launchPower));
+                    sf::Vector2f dragEndPos = m_window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y}, m_camera);
+                    LaunchBird(m_physics, m_level, launchVelocity(dragEndPos));
                 }
             }
         }
     }
 }
 
+    // Velocidad que recibe el pájaro al soltar en dragEndPos
+    b2Vec2 launchVelocity(const sf::Vector2f& dragEndPos) const {
+        sf::Vector2f launchVector = m_dragStartPos - dragEndPos;
+        float launchPower = 0.5f;
+        return b2Vec2(launchVector.x * launchPower, launchVector.y * launchPower);
+    }
+
+    // Desplazamiento con las flechas, más rápido cuanto más alejado el zoom
+    void updateCamera(float dt) {
+        if (!m_window.hasFocus()) {
+            return;
+        }
+        const float speed = 600.f * m_camera.getSize().x / SCREEN_WIDTH;
+        sf::Vector2f move(0.f, 0.f);
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
+            move.x -= speed;
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
+            move.x += speed;
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+            move.y -= speed;
+        }
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
+            move.y += speed;
+        }
+        m_camera.move(move * dt);
+    }
+
+    void zoomCamera(float factor) {
+        float width = m_camera.getSize().x * factor;
+        if (width < SCREEN_WIDTH * 0.25f || width > SCREEN_WIDTH * 4.f) {
+            return;
+        }
+        m_camera.zoom(factor);
+    }
+
+    // Rectángulo visible de la cámara en metros
+    b2AABB visibleArea() const {
+        sf::Vector2f center = m_camera.getCenter();
+        sf::Vector2f half = m_camera.getSize() * 0.5f;
+        b2AABB area;
+        area.lowerBound = pixelsToMeters(center - half);
+        area.upperBound = pixelsToMeters(center + half);
+        return area;
+    }
+
     void update(float dt) {
+        updateCamera(dt);
+
         if (m_gameState == PLAYING) {
             m_physics.Update(dt);
-            if (m_targetBody && m_targetBody->GetPosition().y > (SCREEN_HEIGHT - 40.f) / SCALE) {
+            if (IsLevelWon(m_level)) {
                 m_gameState = WON;
                 m_messageText.setString("¡Ganaste!\nPresiona R para reiniciar");
                 sf::FloatRect textRect = m_messageText.getLocalBounds();
@@ -263,56 +235,60 @@ private:
     void render() {
         m_window.clear(sf::Color(135, 206, 235)); // Sky blue
 
-        for (const auto& body : m_bodies) {
-            b2Fixture* fixture = body->GetFixtureList();
-            while (fixture) {
-                sf::Vector2f pos = metersToPixels(body->GetPosition());
-                float angle = body->GetAngle() * 180.f / b2_pi;
-
-                if (fixture->GetType() == b2Shape::e_circle) {
-                    sf::CircleShape circle(fixture->GetShape()->m_radius * SCALE);
-                    circle.setOrigin(circle.getRadius(), circle.getRadius());
-                    circle.setPosition(pos);
-                    circle.setRotation(angle);
-                    if (body == m_birdBody) {
-                        circle.setFillColor(sf::Color::Red);
-                    } else if (body == m_pigBody) {
-                        circle.setFillColor(sf::Color::Green);
-                    }
-                    m_window.draw(circle);
-                } else if (fixture->GetType() == b2Shape::e_polygon) {
-                    b2PolygonShape* polyShape = (b2PolygonShape*)fixture->GetShape();
-                    int vertexCount = polyShape->m_count;
-                    sf::ConvexShape convex;
-                    convex.setPointCount(vertexCount);
-                    for (int i = 0; i < vertexCount; i++) {
-                        sf::Vector2f point = metersToPixels(polyShape->m_vertices[i]);
-                        convex.setPoint(i, point);
-                    }
-                    convex.setPosition(pos);
-                    convex.setRotation(angle);
-                    convex.setFillColor(sf::Color(139, 69, 19)); // Brown
-                    convex.setOutlineColor(sf::Color::Black);
-                    convex.setOutlineThickness(1.f);
-                    m_window.draw(convex);
-                }
-                fixture = fixture->GetNext();
-            }
+        m_window.setView(m_camera);
+
+        // Solo se visitan los fixtures que solapan la cámara; lo que queda
+        // fuera no cuesta nada al dibujar
+        b2AABB visible = visibleArea();
+        // Antes de la consulta: descongela lo que acaba de entrar en cámara,
+        // que si no faltaría un frame
+        if (m_physics.AreRegionsEnabled()) {
+            m_physics.SetRegionFocusArea(visible);
         }
 
+        m_visibleFixtures.clear();
+        m_physics.QueryAABB(visible, m_visibleFixtures);
+        m_renderStats.visitedFixtures = static_cast<int>(m_visibleFixtures.size());
+        // Los fixtures congelados no están en el broadphase
+        m_renderStats.totalFixtures = m_physics.GetWorld()->GetProxyCount() +
+                                      m_physics.GetRegionStats().frozenFixtures;
+
+        for (b2Fixture* fixture : m_visibleFixtures) {
+            drawFixture(fixture);
+        }
+
+        drawParticles();
+
         sf::RectangleShape ground(sf::Vector2f(SCREEN_WIDTH, 20.f));
         ground.setPosition(0, SCREEN_HEIGHT - 20.f);
         ground.setFillColor(sf::Color(34, 139, 34)); // Dark green
         m_window.draw(ground);
 
         if (m_isDragging) {
+            sf::Vector2f dragEndPos = m_window.mapPixelToCoords(sf::Mouse::getPosition(m_window), m_camera);
+            drawTrajectory(dragEndPos);
+
             sf::Vertex line[] = {
                 sf::Vertex(m_dragStartPos, sf::Color::Black),
-                sf::Vertex(sf::Vector2f(sf::Mouse::getPosition(m_window)), sf::Color::Black)
+                sf::Vertex(dragEndPos, sf::Color::Black)
             };
             m_window.draw(line, 2, sf::Lines);
         }
 
+        if (m_showDebugDraw) {
+            m_physics.DrawDebugData();
+            m_debugDraw.Flush(m_window);
+        }
+
+        // HUD en coordenadas de pantalla
+        m_window.setView(m_window.getDefaultView());
+
+        if (m_showDebugDraw) {
+            m_statsText.setString("Fixtures: " + std::to_string(m_renderStats.visitedFixtures) + " / " +
+                                  std::to_string(m_renderStats.totalFixtures));
+            m_window.draw(m_statsText);
+        }
+
         if (m_gameState == WON) {
             m_window.draw(m_messageText);
         }
@@ -320,24 +296,130 @@ private:
         m_window.display();
     }
 
+    void drawFixture(b2Fixture* fixture) {
+        b2Body* body = fixture->GetBody();
+        // Suelo, muros y techo no se dibujan como cuerpos
+        if (body == m_level.ground || body == m_level.leftWall || body == m_level.rightWall || body == m_level.ceiling) {
+            return;
+        }
+
+        sf::Vector2f pos = metersToPixels(body->GetPosition());
+        float angle = body->GetAngle() * 180.f / b2_pi;
+
+        if (fixture->GetType() == b2Shape::e_circle) {
+            sf::CircleShape circle(fixture->GetShape()->m_radius * SCALE);
+            circle.setOrigin(circle.getRadius(), circle.getRadius());
+            circle.setPosition(pos);
+            circle.setRotation(angle);
+            if (body == m_level.bird) {
+                circle.setFillColor(sf::Color::Red);
+            } else if (body == m_level.pig) {
+                circle.setFillColor(sf::Color::Green);
+            }
+            m_window.draw(circle);
+        } else if (fixture->GetType() == b2Shape::e_polygon) {
+            b2PolygonShape* polyShape = (b2PolygonShape*)fixture->GetShape();
+            int vertexCount = polyShape->m_count;
+            sf::ConvexShape convex;
+            convex.setPointCount(vertexCount);
+            for (int i = 0; i < vertexCount; i++) {
+                sf::Vector2f point = metersToPixels(polyShape->m_vertices[i]);
+                convex.setPoint(i, point);
+            }
+            convex.setPosition(pos);
+            convex.setRotation(angle);
+            convex.setFillColor(sf::Color(139, 69, 19)); // Brown
+            convex.setOutlineColor(sf::Color::Black);
+            convex.setOutlineThickness(1.f);
+            m_window.draw(convex);
+        }
+    }
+
+    // Todas las partículas en un único VertexArray (un quad por partícula)
+    void drawParticles() {
+        const ParticleSystem& particles = m_physics.GetParticles();
+        const size_t count = particles.GetCount();
+        const float* xs = particles.GetPositionsX();
+        const float* ys = particles.GetPositionsY();
+        const float* life = particles.GetLife();
+        const float half = particles.GetRadius() * SCALE;
+
+        m_particleVertices.resize(count * 4);
+        for (size_t i = 0; i < count; ++i) {
+            float x = xs[i] * SCALE;
+            float y = ys[i] * SCALE;
+            sf::Color color(110, 90, 70, static_cast<sf::Uint8>(255.f * std::max(0.f, std::min(1.f, life[i]))));
+
+            sf::Vertex* quad = &m_particleVertices[i * 4];
+            quad[0] = sf::Vertex(sf::Vector2f(x - half, y - half), color);
+            quad[1] = sf::Vertex(sf::Vector2f(x + half, y - half), color);
+            quad[2] = sf::Vertex(sf::Vector2f(x + half, y + half), color);
+            quad[3] = sf::Vertex(sf::Vector2f(x - half, y + half), color);
+        }
+
+        if (count > 0) {
+            m_window.draw(m_particleVertices);
+        }
+    }
+
+    // Arco previsto del lanzamiento: un punto por muestra, más claro cuanto
+    // más lejos, y una marca en el punto de impacto
+    void drawTrajectory(const sf::Vector2f& dragEndPos) {
+        if (!m_level.bird) {
+            return;
+        }
+        const TrajectoryPrediction& trajectory = m_physics.PredictTrajectory(m_level.bird, launchVelocity(dragEndPos));
+        const size_t count = trajectory.points.size();
+
+        m_trajectoryVertices.clear();
+        auto appendDot = [this](const sf::Vector2f& center, float half, const sf::Color& color) {
+            m_trajectoryVertices.append(sf::Vertex(sf::Vector2f(center.x - half, center.y - half), color));
+            m_trajectoryVertices.append(sf::Vertex(sf::Vector2f(center.x + half, center.y - half), color));
+            m_trajectoryVertices.append(sf::Vertex(sf::Vector2f(center.x + half, center.y + half), color));
+            m_trajectoryVertices.append(sf::Vertex(sf::Vector2f(center.x - half, center.y + half), color));
+        };
+
+        for (size_t i = 1; i < count; ++i) {
+            float fade = 1.f - 0.7f * static_cast<float>(i) / count;
+            appendDot(metersToPixels(trajectory.points[i]), 2.f, sf::Color(255, 255, 255, static_cast<sf::Uint8>(255.f * fade)));
+        }
+        if (trajectory.hit) {
+            appendDot(metersToPixels(trajectory.hitPoint), 4.f, sf::Color::Red);
+        }
+
+        if (m_trajectoryVertices.getVertexCount() > 0) {
+            m_window.draw(m_trajectoryVertices);
+        }
+    }
+
     sf::RenderWindow m_window;
     PhysicsWrapper m_physics;
-    std::vector<b2Body*> m_bodies;
-    b2Body* m_birdBody = nullptr;
-    b2Body* m_pigBody = nullptr;
-    b2Body* m_targetBody = nullptr;
-    b2Body* m_groundBody = nullptr;
-    b2Body* m_leftWallBody = nullptr;
-    b2Body* m_rightWallBody = nullptr;
-    b2Body* m_ceilingBody = nullptr;
+    LevelBodies m_level;
 
     bool m_isDragging = false;
     bool m_isBirdLaunched = false;
     sf::Vector2f m_dragStartPos;
     GameState m_gameState;
 
+    sf::VertexArray m_particleVertices{sf::Quads};
+    sf::VertexArray m_trajectoryVertices{sf::Quads};
+
+    SFMLDebugDraw m_debugDraw{SCALE};
+    bool m_showDebugDraw = false;
+
+    // Cámara (pan con flechas, zoom con la rueda) y fixtures visitados al dibujar
+    struct RenderStats {
+        int visitedFixtures = 0;
+        int totalFixtures = 0;
+    };
+
+    sf::View m_camera{sf::FloatRect(0.f, 0.f, SCREEN_WIDTH, SCREEN_HEIGHT)};
+    std::vector<b2Fixture*> m_visibleFixtures;
+    RenderStats m_renderStats;
+
     sf::Font m_font;
     sf::Text m_messageText;
+    sf::Text m_statsText;
 };
 
 int main() {
@@ -0,0 +1,128 @@
+//
+// El lote SIMD de círculos debe dar los mismos contactos que
+// PerformCustomCollisionCheck par a par. Se ejecuta con 'make test'.
+//
+#include "Level.h"
+#include "PhysicsWrapper.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const float kTimeStep = 1.0f / 60.0f;
+    const int kSteps = 400;
+
+    b2Body* CreateDynamicBody(PhysicsWrapper& physics, float x, float y) {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position.Set(x, y);
+        return physics.CreateBody(&bodyDef);
+    }
+
+    void CreateRegularPolygon(PhysicsWrapper& physics, float x, float y, float radius, int count) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        b2Vec2 vertices[b2_maxPolygonVertices];
+        for (int i = 0; i < count; ++i) {
+            float angle = 2.0f * b2_pi * i / count;
+            vertices[i].Set(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        b2PolygonShape shape;
+        shape.Set(vertices, count);
+        physics.CreatePolygonFixture(body, &shape, 1.0f);
+    }
+
+    // Lluvia de bolas sobre el nivel y sobre polígonos de cada slot de kernel
+    // (triángulo, caja, cuadrilátero, hexágono y genérico)
+    void BuildScene(PhysicsWrapper& physics) {
+        LevelBodies level = BuildDefaultLevel(physics);
+        for (b2Body* body : level.dynamicBodies) {
+            body->SetAwake(true);
+        }
+
+        for (int i = 0; i < 6; ++i) {
+            CreateRegularPolygon(physics, 5.0f + i * 2.5f, 18.0f, 0.6f, 3 + i);
+        }
+        for (int row = 0; row < 4; ++row) {
+            for (int i = 0; i < 16; ++i) {
+                float x = 4.0f + i * 1.1f + 0.3f * row;
+                b2Body* ball = CreateDynamicBody(physics, x, 8.0f + row * 1.2f);
+                b2CircleShape circle;
+                circle.m_radius = 0.2f + 0.05f * ((i + row) % 4);
+                physics.CreateCircleFixture(ball, &circle, 1.0f);
+            }
+        }
+    }
+
+    struct Recorded {
+        b2Shape::Type typeA;
+        b2Shape::Type typeB;
+        ContactInfo info;
+    };
+
+    bool SameInfo(const ContactInfo& a, const ContactInfo& b) {
+        return a.hasCollision == b.hasCollision &&
+               std::memcmp(&a.normal, &b.normal, sizeof(b2Vec2)) == 0 &&
+               std::memcmp(&a.depth, &b.depth, sizeof(float)) == 0 &&
+               std::memcmp(&a.contactPoint, &b.contactPoint, sizeof(b2Vec2)) == 0;
+    }
+
+    // Mismo mundo; batchThreshold decide si los círculos van en lote
+    struct Simulation {
+        PhysicsWrapper physics;
+        std::vector<Recorded> contacts;
+
+        explicit Simulation(size_t batchThreshold)
+            : physics(b2Vec2(0.0f, kLevelGravity)) {
+            physics.SetContactLogging(false);
+            physics.SetCircleBatchThreshold(batchThreshold);
+            physics.SetPreSolveCallback([this](b2Fixture* fixtureA, b2Fixture* fixtureB, const ContactInfo& info) {
+                contacts.push_back({ fixtureA->GetType(), fixtureB->GetType(), info });
+                return true;
+            });
+            BuildScene(physics);
+        }
+    };
+}
+
+int main() {
+    Simulation batched(1);
+    Simulation scalar(SIZE_MAX);
+
+    size_t circleContacts = 0;
+    for (int step = 0; step < kSteps; ++step) {
+        batched.contacts.clear();
+        scalar.contacts.clear();
+        batched.physics.Update(kTimeStep);
+        scalar.physics.Update(kTimeStep);
+
+        if (batched.contacts.size() != scalar.contacts.size()) {
+            std::cerr << "[CircleBatchTest] Paso " << step << ": " << batched.contacts.size()
+                      << " contactos en lote frente a " << scalar.contacts.size() << " uno a uno" << std::endl;
+            return 1;
+        }
+        for (size_t i = 0; i < batched.contacts.size(); ++i) {
+            const Recorded& a = batched.contacts[i];
+            const Recorded& b = scalar.contacts[i];
+            if (a.typeA != b.typeA || a.typeB != b.typeB || !SameInfo(a.info, b.info)) {
+                std::cerr << "[CircleBatchTest] Paso " << step << ", contacto " << i << ": normal ("
+                          << a.info.normal.x << ", " << a.info.normal.y << ") frente a ("
+                          << b.info.normal.x << ", " << b.info.normal.y << "), profundidad "
+                          << a.info.depth << " frente a " << b.info.depth << std::endl;
+                return 1;
+            }
+            if (a.typeA == b2Shape::e_circle || a.typeB == b2Shape::e_circle) {
+                ++circleContacts;
+            }
+        }
+    }
+
+    if (circleContacts == 0) {
+        std::cerr << "[CircleBatchTest] La escena no generó contactos con círculos" << std::endl;
+        return 1;
+    }
+    std::cout << "[CircleBatchTest] OK: " << circleContacts << " contactos con círculos idénticos en "
+              << kSteps << " pasos" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+//
+// Una escena en reposo no debe asignar memoria en Update.
+// Se ejecuta con 'make test'.
+//
+#include "Level.h"
+#include "MemoryTracker.h"
+#include "PhysicsWrapper.h"
+#include <cmath>
+#include <iostream>
+
+namespace {
+    const float kTimeStep = 1.0f / 60.0f;
+    const int kSettleSteps = 300;
+    const int kCheckedSteps = 120;
+
+    b2Body* CreateDynamicBody(PhysicsWrapper& physics, float x, float y) {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position.Set(x, y);
+        return physics.CreateBody(&bodyDef);
+    }
+
+    // Polígono regular de count lados; el pentágono va por el camino genérico
+    void CreateRegularPolygon(PhysicsWrapper& physics, float x, float y, float radius, int count) {
+        b2Body* body = CreateDynamicBody(physics, x, y);
+        b2Vec2 vertices[b2_maxPolygonVertices];
+        for (int i = 0; i < count; ++i) {
+            float angle = 2.0f * b2_pi * i / count;
+            vertices[i].Set(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        b2PolygonShape shape;
+        shape.Set(vertices, count);
+        physics.CreatePolygonFixture(body, &shape, 1.0f);
+    }
+
+    // Nivel por defecto más una fila de bolas sobre el suelo, para que los
+    // contactos círculo-polígono pasen por el lote SIMD
+    void BuildScene(PhysicsWrapper& physics) {
+        LevelBodies level = BuildDefaultLevel(physics);
+        for (b2Body* body : level.dynamicBodies) {
+            body->SetAwake(true);
+        }
+
+        const b2Vec2 groundCenter = level.ground->GetPosition();
+        const float groundTop = groundCenter.y - 10.0f / 30.0f;
+        for (int i = 0; i < 12; ++i) {
+            b2Body* ball = CreateDynamicBody(physics, 4.0f + i * 0.8f, groundTop - 0.3f);
+            b2CircleShape circle;
+            circle.m_radius = 0.3f;
+            physics.CreateCircleFixture(ball, &circle, 1.0f);
+        }
+        CreateRegularPolygon(physics, 15.0f, groundTop - 0.5f, 0.5f, 5);
+        CreateRegularPolygon(physics, 17.0f, groundTop - 0.5f, 0.5f, 6);
+    }
+}
+
+int main() {
+    PhysicsWrapper physics(b2Vec2(0.0f, kLevelGravity));
+    physics.SetContactLogging(false);
+    // Sin dormir: todos los contactos pasan por la detección en cada paso
+    physics.GetWorld()->SetAllowSleeping(false);
+    BuildScene(physics);
+
+    for (int i = 0; i < kSettleSteps; ++i) {
+        physics.Update(kTimeStep);
+    }
+
+    int failures = 0;
+    for (int i = 0; i < kCheckedSteps; ++i) {
+        physics.Update(kTimeStep);
+        const MemoryStats& stats = physics.GetMemoryStats();
+        if (stats.stepAllocations != 0) {
+            std::cerr << "[StepAllocationTest] Paso " << i << ": " << stats.stepAllocations
+                      << " asignaciones (" << stats.stepBytes << " bytes)" << std::endl;
+            ++failures;
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << "[StepAllocationTest] FALLO: " << failures << " de " << kCheckedSteps
+                  << " pasos asignaron memoria" << std::endl;
+        return 1;
+    }
+    std::cout << "[StepAllocationTest] OK: " << kCheckedSteps << " pasos sin asignaciones ("
+              << physics.GetWorld()->GetContactCount() << " contactos)" << std::endl;
+    return 0;
+}